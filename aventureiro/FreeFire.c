@@ -1,88 +1,294 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L // pread, fdatasync, clock_gettime (../comum/wal.h, ../comum/cronometro.h)
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 
-#define MAX_ITENS 10
+#include "../comum/inventario.h"
+#include "../comum/indice.h"
+#include "../comum/pool.h"
+#include "../comum/arvoreb.h"
+#include "../comum/chave.h"
+#include "../comum/ordenacao.h"
+#include "../comum/entrada.h"
+#include "../comum/lote.h"
+#include "../comum/cronometro.h"
+#include "../comum/snapshot.h"
+#include "../comum/wal.h"
+#include "../comum/tabela.h"
 
 // ============================================
 // STRUCTS
 // ============================================
 
+#define TAM_NOME_ITEM 30
+#define TAM_TIPO_ITEM 20
+
 // Estrutura básica de item
 typedef struct {
-    char nome[30];
-    char tipo[20];
+    char nome[TAM_NOME_ITEM];
+    char tipo[TAM_TIPO_ITEM];
     int quantidade;
 } Item;
 
-// Nó da lista encadeada
+// Mochila em vetor: itens, índice hash e estado de ordenação
+typedef struct {
+    Arena arena;
+    Inventario itens;
+    IndiceNome indice; // nome -> posição no vetor
+    int ordenado;      // ordenado por nome? (daí em diante inserções mantêm a ordem)
+    Snapshot snapshot; // região mapeada para onde 'itens' pode apontar
+    Wal log;           // com --wal: cada operação vai ao log (ver abrirLogVetor)
+} MochilaVetor;
+
+// Nó da lista encadeada (dupla: o índice leva direto ao nó, e tirá-lo
+// da lista precisa do anterior)
 typedef struct No {
     Item dados;
     struct No* proximo;
+    struct No* anterior;
+    struct No* mesmoNome; // próximo nó com o mesmo nome (mais antigo)
 } No;
 
+// Índice hash da lista (endereçamento aberto, sondagem linear): nome ->
+// nó mais recente com esse nome; os mais antigos seguem por 'mesmoNome'
+typedef struct {
+    No** nos;          // NULL = vazio, NO_REMOVIDO = lápide
+    uint32_t* hashes;
+    int capacidade;    // potência de 2
+    int ocupados;      // entradas válidas
+    int usados;        // válidas + lápides
+} IndiceLista;
+
+// Mochila em lista: os nós vêm de um pool próprio, em blocos contíguos
+typedef struct {
+    PoolNos pool;
+    No* inicio;
+    IndiceLista indice;
+    Wal log;
+} MochilaLista;
+
+// Nó da lista desenrolada: vários itens seguidos por nó
+#define ITENS_POR_BLOCO 8
+
+typedef struct BlocoItens {
+    int quantidade; // posições ocupadas em itens[]
+    struct BlocoItens* proximo;
+    Item itens[ITENS_POR_BLOCO];
+} BlocoItens;
+
+// Mochila em lista desenrolada: meio-termo entre vetor e lista
+typedef struct {
+    PoolNos pool;
+    BlocoItens* inicio;
+    BlocoItens* fim;
+    int tamanho;
+} MochilaDesenrolada;
+
+// Mochila em árvore B: itens sempre em ordem de nome
+typedef struct {
+    ArvoreB arvore;
+} MochilaArvore;
+
 // ============================================
 // VARIÁVEIS GLOBAIS DE CONTAGEM DE COMPARAÇÕES
 // ============================================
 int comparacoesSequencialVetor = 0;
 int comparacoesBinaria = 0;
 int comparacoesSequencialLista = 0;
+int comparacoesSequencialDesenrolada = 0;
+int comparacoesArvore = 0;
+int comparacoesHash = 0; // sondagens na tabela hash
+int comparacoesHashLista = 0;
+int comparacoesPrefixo = 0;
+
+
+// ============================================
+// ESTATÍSTICAS DE TEMPO POR OPERAÇÃO
+// ============================================
+typedef enum {
+    EST_VETOR_INSERCAO,
+    EST_VETOR_REMOCAO,
+    EST_VETOR_BUSCA_SEQ,
+    EST_VETOR_BUSCA_BIN,
+    EST_VETOR_BUSCA_HASH,
+    EST_VETOR_BUSCA_PREFIXO,
+    EST_VETOR_ORDENACAO,
+    EST_LISTA_INSERCAO,
+    EST_LISTA_REMOCAO,
+    EST_LISTA_BUSCA_SEQ,
+    EST_LISTA_BUSCA_HASH,
+    EST_DESENROLADA_INSERCAO,
+    EST_DESENROLADA_REMOCAO,
+    EST_DESENROLADA_BUSCA_SEQ,
+    EST_ARVORE_INSERCAO,
+    EST_ARVORE_REMOCAO,
+    EST_ARVORE_BUSCA,
+    EST_ARVORE_BUSCA_PREFIXO,
+    NUM_ESTATISTICAS_MOCHILA
+} TipoEstatisticaMochila;
+
+Histograma estatisticasMochila[NUM_ESTATISTICAS_MOCHILA];
+
+void iniciarEstatisticasMochila() {
+    const char* nomes[NUM_ESTATISTICAS_MOCHILA] = {
+        "Vetor: inserção", "Vetor: remoção", "Vetor: busca sequencial",
+        "Vetor: busca binária", "Vetor: busca hash", "Vetor: busca prefixo", "Vetor: ordenação",
+        "Lista: inserção", "Lista: remoção", "Lista: busca sequencial", "Lista: busca hash",
+        "Desenrolada: inserção", "Desenrolada: remoção", "Desenrolada: busca seq.",
+        "Árvore B: inserção", "Árvore B: remoção", "Árvore B: busca", "Árvore B: busca prefixo"
+    };
+    for (int i = 0; i < NUM_ESTATISTICAS_MOCHILA; i++)
+        histograma_iniciar(&estatisticasMochila[i], nomes[i]);
+}
+
+void mostrarEstatisticasMochila() {
+    printf("\n===== Estatísticas de tempo (relógio monotônico) =====\n");
+    histograma_imprimirTabela(estatisticasMochila, NUM_ESTATISTICAS_MOCHILA);
+    for (int i = 0; i < NUM_ESTATISTICAS_MOCHILA; i++)
+        histograma_imprimirBarras(&estatisticasMochila[i]);
+}
 
 
 // ============================================
 // FUNÇÕES DO VETOR
 // ============================================
 
-// Inserir item no vetor
-void inserirItemVetor(Item vetor[], int* tamanho) {
-    if (*tamanho >= MAX_ITENS) {
-        printf("\nA mochila (vetor) está cheia!\n");
-        return;
+void iniciarMochilaVetor(MochilaVetor* m) {
+    arena_iniciar(&m->arena);
+    inventario_iniciar(&m->itens, &m->arena, sizeof(Item));
+    indice_iniciar(&m->indice, &m->itens, offsetof(Item, nome));
+    m->ordenado = 0;
+    snapshot_iniciar(&m->snapshot);
+    wal_iniciar(&m->log);
+}
+
+void liberarMochilaVetor(MochilaVetor* m) {
+    wal_fechar(&m->log); // espera a compactação, que lê os itens
+    indice_liberar(&m->indice);
+    arena_liberar(&m->arena);
+    snapshot_liberar(&m->snapshot);
+}
+
+// Posição onde 'nome' entra num vetor ordenado: depois dos nomes iguais,
+// para que itens repetidos fiquem na ordem de chegada
+int posicaoOrdenadaVetor(Item vetor[], int tamanho, const char* nome) {
+    int inicio = 0, fim = tamanho;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (chave_comparar(vetor[meio].nome, nome, TAM_NOME_ITEM) <= 0) inicio = meio + 1;
+        else fim = meio;
     }
+    return inicio;
+}
 
-    Item novo;
+// Adiciona o item ao vetor e ao índice (sem entrada/saída). Se o vetor já
+// está ordenado, o item entra na posição certa com um único deslocamento
+// em bloco, e a busca binária continua valendo; senão vai para o fim.
+void adicionarItemVetor(MochilaVetor* m, const Item* item) {
+    Medicao med = medicao_iniciar();
+    if (m->ordenado) {
+        int pos = posicaoOrdenadaVetor((Item*)m->itens.dados, m->itens.tamanho, item->nome);
+        indice_deslocar(&m->indice, pos, +1);
+        *(Item*)inventario_inserirEm(&m->itens, pos) = *item;
+        indice_inserir(&m->indice, pos);
+    } else {
+        *(Item*)inventario_anexar(&m->itens) = *item;
+        indice_inserir(&m->indice, m->itens.tamanho - 1);
+    }
+    wal_registrar(&m->log, WAL_OP_INSERIR, item, sizeof(Item));
+    medicao_registrar(&med, &estatisticasMochila[EST_VETOR_INSERCAO]);
+}
+
+// Remove pelo nome, localizando pelo índice hash. Se o vetor estiver
+// ordenado, desloca os seguintes para manter a ordem; senão o último item
+// ocupa a vaga (O(1)). Retorna 1 se removeu, 0 se não encontrou.
+int retirarItemVetor(MochilaVetor* m, const char* nome) {
+    Medicao med = medicao_iniciar();
+    int pos = indice_buscar(&m->indice, nome, NULL);
+
+    if (pos >= 0 && m->ordenado) {
+        indice_remover(&m->indice, pos);
+        inventario_remover(&m->itens, pos);
+        indice_deslocar(&m->indice, pos + 1, -1);
+    } else if (pos >= 0) {
+        indice_removerTrocandoUltimo(&m->indice, &m->itens, pos);
+    }
+    if (pos >= 0) wal_registrar(&m->log, WAL_OP_REMOVER, nome, strlen(nome) + 1);
+    medicao_registrar(&med, &estatisticasMochila[EST_VETOR_REMOCAO]);
+    return pos >= 0;
+}
+
+// Grava os itens do vetor num snapshot binário (mesmo formato do novato)
+int salvarMochilaVetor(MochilaVetor* m, const char* caminho) {
+    return snapshot_gravar(caminho, "ITEM", m->itens.dados, sizeof(Item), m->itens.tamanho,
+                           m->ordenado ? SNAPSHOT_ORDENADO_NOME : 0, 0);
+}
 
-    printf("\nNome do item: ");
-    scanf("%s", novo.nome);
+// Substitui os itens pelo snapshot: o vetor passa a apontar para a região
+// mapeada (copiado só se crescer) e o índice hash é refeito
+int carregarMochilaVetor(MochilaVetor* m, const char* caminho) {
+    Snapshot novo;
+    if (!snapshot_carregar(&novo, caminho, "ITEM", sizeof(Item))) return 0;
+    inventario_adotar(&m->itens, novo.registros, novo.quantidade);
+    snapshot_liberar(&m->snapshot);
+    m->snapshot = novo;
+    m->ordenado = (novo.flags & SNAPSHOT_ORDENADO_NOME) != 0;
+    indice_reconstruir(&m->indice);
+    return 1;
+}
 
-    printf("Tipo: ");
-    scanf("%s", novo.tipo);
+// Inserir item no vetor (cresce conforme necessário)
+void inserirItemVetor(MochilaVetor* m) {
+    Item novo;
+    memset(&novo, 0, sizeof(novo));
 
-    printf("Quantidade: ");
-    scanf("%d", &novo.quantidade);
+    if (!entrada_lerTexto("\nNome do item: ", novo.nome, sizeof(novo.nome))) return;
+    if (!entrada_lerTexto("Tipo: ", novo.tipo, sizeof(novo.tipo))) return;
+    if (!entrada_lerInteiro("Quantidade: ", &novo.quantidade)) return;
 
-    vetor[*tamanho] = novo;
-    (*tamanho)++;
+    adicionarItemVetor(m, &novo);
+    wal_sincronizar(&m->log); // só confirma depois de gravado
 
     printf("\nItem inserido no vetor!\n");
 }
 
 // Remover item do vetor
-void removerItemVetor(Item vetor[], int* tamanho) {
-    if (*tamanho == 0) {
+void removerItemVetor(MochilaVetor* m) {
+    if (m->itens.tamanho == 0) {
         printf("\nO vetor está vazio.\n");
         return;
     }
 
     char nome[30];
-    printf("\nNome do item para remover: ");
-    scanf("%s", nome);
+    if (!entrada_lerTexto("\nNome do item para remover: ", nome, sizeof(nome))) return;
 
-    for (int i = 0; i < *tamanho; i++) {
-        if (strcmp(vetor[i].nome, nome) == 0) {
-            for (int j = i; j < *tamanho - 1; j++) {
-                vetor[j] = vetor[j + 1];
-            }
-            (*tamanho)--;
-            printf("\nItem removido do vetor!\n");
-            return;
-        }
+    if (!retirarItemVetor(m, nome)) {
+        printf("\nItem não encontrado.\n");
+        return;
     }
-
-    printf("\nItem não encontrado.\n");
+    wal_sincronizar(&m->log);
+    printf("\nItem removido do vetor!\n");
 }
 
 // Listar itens do vetor
+// Linha de listagem de um item, montada no buffer de saída
+// (../comum/tabela.h); quem lista chama saida_descarregar() no fim
+void escreverLinhaItem(const Item* item) {
+    BufferSaida* s = &saida_tabela;
+    saida_linha(s);
+    saida_texto(s, "Nome: ");
+    saida_texto(s, item->nome);
+    saida_texto(s, " | Tipo: ");
+    saida_texto(s, item->tipo);
+    saida_texto(s, " | Quantidade: ");
+    saida_inteiro(s, item->quantidade, 0);
+    saida_caractere(s, '\n');
+}
+
 void listarVetor(Item vetor[], int tamanho) {
     printf("\n===== Itens no Vetor =====\n");
 
@@ -92,64 +298,99 @@ void listarVetor(Item vetor[], int tamanho) {
     }
 
     for (int i = 0; i < tamanho; i++) {
-        printf("Nome: %s | Tipo: %s | Quantidade: %d\n",
-               vetor[i].nome, vetor[i].tipo, vetor[i].quantidade);
+        escreverLinhaItem(&vetor[i]);
     }
+    saida_descarregar(&saida_tabela);
 }
 
-// Busca sequencial no vetor
+// Busca sequencial no vetor: varre os campos de nome em blocos de 16
+// bytes (../comum/chave.h); cada item examinado conta uma comparação
 int buscarSequencialVetor(Item vetor[], int tamanho, char nome[]) {
-    comparacoesSequencialVetor = 0;
+    Medicao med = medicao_iniciar();
+    ChaveBusca k;
+    chave_preparar(&k, nome, TAM_NOME_ITEM);
+    int achou = tamanho > 0 ? chave_procurar(vetor[0].nome, sizeof(Item), tamanho, &k) : -1;
+    comparacoesSequencialVetor = achou < 0 ? tamanho : achou + 1;
+    medicao_registrar(&med, &estatisticasMochila[EST_VETOR_BUSCA_SEQ]);
+    return achou;
+}
 
-    for (int i = 0; i < tamanho; i++) {
-        comparacoesSequencialVetor++;
+// Busca pelo índice hash; conta sondagens em comparacoesHash
+int buscarHashVetor(IndiceNome* indice, char nome[]) {
+    Medicao med = medicao_iniciar();
+    comparacoesHash = 0;
+    int pos = indice_buscar(indice, nome, &comparacoesHash);
+    medicao_registrar(&med, &estatisticasMochila[EST_VETOR_BUSCA_HASH]);
+    return pos;
+}
 
-        if (strcmp(vetor[i].nome, nome) == 0) {
-            return i;
-        }
-    }
-    return -1;
+// Compara dois itens pelo nome (para o motor de ordenação)
+int compararNomeItem(const void* a, const void* b) {
+    return chave_comparar(((const Item*)a)->nome, ((const Item*)b)->nome, TAM_NOME_ITEM);
 }
 
-// Ordenar vetor (Bubble Sort)
+// Ordenar vetor por nome (Merge Sort estável sobre índices, O(n log n))
 void ordenarVetor(Item vetor[], int tamanho) {
-    Item temp;
-
-    for (int i = 0; i < tamanho - 1; i++) {
-        for (int j = 0; j < tamanho - 1 - i; j++) {
-            if (strcmp(vetor[j].nome, vetor[j + 1].nome) > 0) {
-                temp = vetor[j];
-                vetor[j] = vetor[j + 1];
-                vetor[j + 1] = temp;
-            }
-        }
+    Medicao med = medicao_iniciar();
+    if (tamanho > 1) {
+        int* perm = (int*)ordenacao_alocar((size_t)tamanho * sizeof(int));
+        ordenacao_identidade(perm, tamanho);
+        ordenacao_mergesort(vetor, sizeof(Item), perm, tamanho, compararNomeItem);
+        ordenacao_aplicarPermutacao(vetor, sizeof(Item), perm, tamanho);
+        free(perm);
     }
+    medicao_registrar(&med, &estatisticasMochila[EST_VETOR_ORDENACAO]);
+}
 
-    printf("\nVetor ordenado por nome!\n");
+// Ordena a mochila por nome; daí em diante as inserções mantêm a ordem
+void ordenarMochilaVetor(MochilaVetor* m) {
+    ordenarVetor((Item*)m->itens.dados, m->itens.tamanho);
+    indice_reconstruir(&m->indice);
+    m->ordenado = 1;
+    wal_registrar(&m->log, WAL_OP_ORDENAR, NULL, 0);
 }
 
 // Busca binária no vetor ordenado
 int buscarBinariaVetor(Item vetor[], int tamanho, char nome[]) {
+    Medicao med = medicao_iniciar();
+    int achou = -1;
     comparacoesBinaria = 0;
 
     int inicio = 0;
     int fim = tamanho - 1;
+    ChaveBusca k;
+    chave_preparar(&k, nome, TAM_NOME_ITEM);
 
     while (inicio <= fim) {
         int meio = (inicio + fim) / 2;
         comparacoesBinaria++;
 
-        int cmp = strcmp(vetor[meio].nome, nome);
+        int cmp = chave_comparar(vetor[meio].nome, k.texto, TAM_NOME_ITEM);
 
         if (cmp == 0) {
-            return meio;
+            achou = meio;
+            break;
         } else if (cmp < 0) {
             inicio = meio + 1;
         } else {
             fim = meio - 1;
         }
     }
-    return -1;
+    medicao_registrar(&med, &estatisticasMochila[EST_VETOR_BUSCA_BIN]);
+    return achou;
+}
+
+// Busca por começo do nome (autocompletar) no vetor ordenado: os nomes
+// com o prefixo formam uma faixa contígua, achada com duas buscas binárias.
+// Devolve quantos itens casam; o primeiro fica em *inicio.
+int buscarPrefixoVetor(Item vetor[], int tamanho, const char* prefixo, int* inicio) {
+    Medicao med = medicao_iniciar();
+    long comps = 0;
+    int total = chave_faixaPrefixo(tamanho > 0 ? vetor[0].nome : NULL, sizeof(Item), tamanho, TAM_NOME_ITEM,
+                                   prefixo, inicio, &comps);
+    comparacoesPrefixo = (int)comps;
+    medicao_registrar(&med, &estatisticasMochila[EST_VETOR_BUSCA_PREFIXO]);
+    return total;
 }
 
 
@@ -157,55 +398,175 @@ int buscarBinariaVetor(Item vetor[], int tamanho, char nome[]) {
 // FUNÇÕES DA LISTA ENCADEADA
 // ============================================
 
-// Inserir item na lista
-void inserirItemLista(No** lista) {
-    No* novo = (No*)malloc(sizeof(No));
+// --- Índice hash da lista ---
+// A lápide é um endereço que nunca é um nó
+static No noRemovido;
+#define NO_REMOVIDO (&noRemovido)
+#define INDICE_LISTA_CAP_INICIAL 64
+
+void alocarIndiceLista(IndiceLista* idx, int capacidade) {
+    idx->nos = (No**)calloc((size_t)capacidade, sizeof(No*));
+    idx->hashes = (uint32_t*)malloc((size_t)capacidade * sizeof(uint32_t));
+    if (idx->nos == NULL || idx->hashes == NULL) {
+        fprintf(stderr, "Memória insuficiente (índice da lista).\n");
+        exit(1);
+    }
+    idx->capacidade = capacidade;
+    idx->ocupados = 0;
+    idx->usados = 0;
+}
+
+void liberarIndiceLista(IndiceLista* idx) {
+    free(idx->nos);
+    free(idx->hashes);
+    idx->nos = NULL;
+    idx->hashes = NULL;
+    idx->capacidade = idx->ocupados = idx->usados = 0;
+}
 
-    printf("\nNome do item: ");
-    scanf("%s", novo->dados.nome);
+// Põe (hash, nó) no primeiro espaço livre da cadeia; não verifica carga
+void colocarIndiceLista(IndiceLista* idx, uint32_t h, No* no) {
+    int mascara = idx->capacidade - 1;
+    int i = (int)(h & (uint32_t)mascara);
+    while (idx->nos[i] != NULL && idx->nos[i] != NO_REMOVIDO) i = (i + 1) & mascara;
+    if (idx->nos[i] == NULL) idx->usados++;
+    idx->hashes[i] = h;
+    idx->nos[i] = no;
+    idx->ocupados++;
+}
 
-    printf("Tipo: ");
-    scanf("%s", novo->dados.tipo);
+// Refaz a tabela sem lápides; dobra se estiver mais da metade cheia
+void redimensionarIndiceLista(IndiceLista* idx) {
+    No** nos = idx->nos;
+    uint32_t* hashes = idx->hashes;
+    int capAntiga = idx->capacidade;
+    int novaCap = capAntiga;
+    while (idx->ocupados + 1 > novaCap / 2) novaCap *= 2;
+
+    alocarIndiceLista(idx, novaCap);
+    for (int i = 0; i < capAntiga; i++) {
+        if (nos[i] != NULL && nos[i] != NO_REMOVIDO) colocarIndiceLista(idx, hashes[i], nos[i]);
+    }
+    free(nos);
+    free(hashes);
+}
+
+// Espaço da tabela com o nome (ou -1); cada espaço visitado é uma sondagem
+int localizarIndiceLista(const IndiceLista* idx, const char* nome, int* sondagens) {
+    uint32_t h = indice_hash(nome);
+    int mascara = idx->capacidade - 1;
+    int i = (int)(h & (uint32_t)mascara);
+    int s = 0;
+    while (idx->nos[i] != NULL) {
+        s++;
+        No* no = idx->nos[i];
+        if (no != NO_REMOVIDO && idx->hashes[i] == h && strcmp(no->dados.nome, nome) == 0) {
+            if (sondagens) *sondagens = s;
+            return i;
+        }
+        i = (i + 1) & mascara;
+    }
+    if (sondagens) *sondagens = s + 1; // o espaço vazio também foi examinado
+    return -1;
+}
+
+// --- Operações da lista ---
+
+void iniciarMochilaLista(MochilaLista* m) {
+    pool_iniciar(&m->pool, sizeof(No));
+    m->inicio = NULL;
+    alocarIndiceLista(&m->indice, INDICE_LISTA_CAP_INICIAL);
+    wal_iniciar(&m->log);
+}
+
+// Descarta a lista inteira de uma vez (não percorre os nós)
+void liberarMochilaLista(MochilaLista* m) {
+    wal_fechar(&m->log);
+    pool_liberar(&m->pool);
+    liberarIndiceLista(&m->indice);
+    m->inicio = NULL;
+}
+
+// Insere o item no início da lista (sem entrada/saída). Se o nome já
+// existe, o nó novo passa a ser o do índice e guarda o anterior em mesmoNome.
+void adicionarItemLista(MochilaLista* m, const Item* item) {
+    Medicao med = medicao_iniciar();
+    No* novo = (No*)pool_alocar(&m->pool);
+    novo->dados = *item;
+    novo->anterior = NULL;
+    novo->proximo = m->inicio;
+    if (m->inicio != NULL) m->inicio->anterior = novo;
+    m->inicio = novo;
+
+    IndiceLista* idx = &m->indice;
+    int i = localizarIndiceLista(idx, novo->dados.nome, NULL);
+    if (i >= 0) {
+        novo->mesmoNome = idx->nos[i];
+        idx->nos[i] = novo;
+    } else {
+        novo->mesmoNome = NULL;
+        if ((idx->usados + 1) * 10 > idx->capacidade * 7) redimensionarIndiceLista(idx);
+        colocarIndiceLista(idx, indice_hash(novo->dados.nome), novo);
+    }
+    wal_registrar(&m->log, WAL_OP_INSERIR, item, sizeof(Item));
+    medicao_registrar(&med, &estatisticasMochila[EST_LISTA_INSERCAO]);
+}
+
+// Remove o primeiro nó com o nome (o mais recente: a lista só cresce pelo
+// início), achado pelo índice em O(1). Retorna 1 se removeu, 0 se não encontrou.
+int retirarItemLista(MochilaLista* m, const char* nome) {
+    Medicao med = medicao_iniciar();
+    IndiceLista* idx = &m->indice;
+    int i = localizarIndiceLista(idx, nome, NULL);
+    if (i >= 0) {
+        No* alvo = idx->nos[i];
+        if (alvo->mesmoNome != NULL) {
+            idx->nos[i] = alvo->mesmoNome;
+        } else {
+            idx->nos[i] = NO_REMOVIDO;
+            idx->ocupados--;
+        }
+        if (alvo->anterior != NULL) alvo->anterior->proximo = alvo->proximo;
+        else m->inicio = alvo->proximo;
+        if (alvo->proximo != NULL) alvo->proximo->anterior = alvo->anterior;
+        pool_devolver(&m->pool, alvo);
+        wal_registrar(&m->log, WAL_OP_REMOVER, nome, strlen(nome) + 1);
+    }
+    medicao_registrar(&med, &estatisticasMochila[EST_LISTA_REMOCAO]);
+    return i >= 0;
+}
+
+// Inserir item na lista
+void inserirItemLista(MochilaLista* m) {
+    Item novo;
+    memset(&novo, 0, sizeof(novo));
 
-    printf("Quantidade: ");
-    scanf("%d", &novo->dados.quantidade);
+    if (!entrada_lerTexto("\nNome do item: ", novo.nome, sizeof(novo.nome))) return;
+    if (!entrada_lerTexto("Tipo: ", novo.tipo, sizeof(novo.tipo))) return;
+    if (!entrada_lerInteiro("Quantidade: ", &novo.quantidade)) return;
 
-    novo->proximo = *lista;
-    *lista = novo;
+    adicionarItemLista(m, &novo);
+    wal_sincronizar(&m->log);
 
     printf("\nItem inserido na lista!\n");
 }
 
 // Remover item da lista
-void removerItemLista(No** lista) {
-    if (*lista == NULL) {
+void removerItemLista(MochilaLista* m) {
+    if (m->inicio == NULL) {
         printf("\nLista vazia.\n");
         return;
     }
 
     char nome[30];
-    printf("\nNome do item para remover: ");
-    scanf("%s", nome);
+    if (!entrada_lerTexto("\nNome do item para remover: ", nome, sizeof(nome))) return;
 
-    No *atual = *lista, *anterior = NULL;
-
-    while (atual != NULL) {
-        if (strcmp(atual->dados.nome, nome) == 0) {
-            if (anterior == NULL)
-                *lista = atual->proximo;
-            else
-                anterior->proximo = atual->proximo;
-
-            free(atual);
-            printf("\nItem removido da lista!\n");
-            return;
-        }
-
-        anterior = atual;
-        atual = atual->proximo;
+    if (retirarItemLista(m, nome)) {
+        wal_sincronizar(&m->log);
+        printf("\nItem removido da lista!\n");
+    } else {
+        printf("\nItem não encontrado.\n");
     }
-
-    printf("\nItem não encontrado.\n");
 }
 
 // Listar itens da lista
@@ -218,26 +579,407 @@ void listarLista(No* lista) {
     }
 
     while (lista != NULL) {
-        printf("Nome: %s | Tipo: %s | Quantidade: %d\n",
-               lista->dados.nome, lista->dados.tipo, lista->dados.quantidade);
+        escreverLinhaItem(&lista->dados);
         lista = lista->proximo;
     }
+    saida_descarregar(&saida_tabela);
 }
 
 // Busca sequencial na lista
 No* buscarSequencialLista(No* lista, char nome[]) {
+    Medicao med = medicao_iniciar();
     comparacoesSequencialLista = 0;
+    ChaveBusca k;
+    chave_preparar(&k, nome, TAM_NOME_ITEM);
 
     while (lista != NULL) {
         comparacoesSequencialLista++;
 
-        if (strcmp(lista->dados.nome, nome) == 0) {
-            return lista;
+        if (chave_igual(lista->dados.nome, &k)) {
+            break;
         }
 
         lista = lista->proximo;
     }
-    return NULL;
+    medicao_registrar(&med, &estatisticasMochila[EST_LISTA_BUSCA_SEQ]);
+    return lista;
+}
+
+// Busca pelo índice hash da lista; conta sondagens em comparacoesHashLista
+No* buscarHashLista(MochilaLista* m, const char* nome) {
+    Medicao med = medicao_iniciar();
+    comparacoesHashLista = 0;
+    int i = localizarIndiceLista(&m->indice, nome, &comparacoesHashLista);
+    medicao_registrar(&med, &estatisticasMochila[EST_LISTA_BUSCA_HASH]);
+    return i >= 0 ? m->indice.nos[i] : NULL;
+}
+
+
+// ============================================
+// PERSISTÊNCIA (--wal <base>)
+// ============================================
+// Vetor e lista têm cada um um snapshot (<base>.vetor.snap,
+// <base>.lista.snap) e um log de operações (.log) reproduzido por cima
+// dele ao entrar na estrutura.
+
+const char* baseWal = NULL; // valor de --wal; NULL: sem persistência
+
+int arquivoExiste(const char* caminho) {
+    FILE* f = fopen(caminho, "rb");
+    if (f == NULL) return 0;
+    fclose(f);
+    return 1;
+}
+
+// Nome gravado por uma remoção (sempre terminado em '\0')
+void nomeDoLog(char nome[30], const void* dados, size_t tamanho) {
+    memcpy(nome, dados, tamanho < 30 ? tamanho : 30);
+    nome[tamanho < 30 ? tamanho : 29] = '\0';
+}
+
+void aplicarOperacaoVetor(void* contexto, int op, const void* dados, size_t tamanho) {
+    MochilaVetor* m = (MochilaVetor*)contexto;
+    char nome[30];
+    if (op == WAL_OP_INSERIR && tamanho == sizeof(Item)) {
+        adicionarItemVetor(m, (const Item*)dados);
+    } else if (op == WAL_OP_REMOVER && tamanho > 0) {
+        nomeDoLog(nome, dados, tamanho);
+        retirarItemVetor(m, nome);
+    } else if (op == WAL_OP_ORDENAR) {
+        ordenarMochilaVetor(m);
+    }
+}
+
+int gravarSnapshotVetor(void* contexto, const char* caminho, uint64_t sequencia) {
+    MochilaVetor* m = (MochilaVetor*)contexto;
+    return snapshot_gravar(caminho, "ITEM", m->itens.dados, sizeof(Item), m->itens.tamanho,
+                           m->ordenado ? SNAPSHOT_ORDENADO_NOME : 0, sequencia);
+}
+
+// Carrega o snapshot, reproduz o log e passa a registrar. O log só é
+// ligado no fim, para a reprodução não se registrar de novo.
+int abrirLogVetor(MochilaVetor* m, const char* base) {
+    char caminhoSnap[512], caminhoLog[512];
+    snprintf(caminhoSnap, sizeof(caminhoSnap), "%s.vetor.snap", base);
+    snprintf(caminhoLog, sizeof(caminhoLog), "%s.vetor.log", base);
+    if (arquivoExiste(caminhoSnap) && !carregarMochilaVetor(m, caminhoSnap)) return 0;
+
+    Wal log;
+    int n = wal_abrir(&log, caminhoLog, "ITEM", m->snapshot.sequencia, aplicarOperacaoVetor, m);
+    if (n < 0) return 0;
+    wal_definirCompactacao(&log, caminhoSnap, WAL_LIMITE_COMPACTACAO, gravarSnapshotVetor, m);
+    m->log = log;
+    return 1;
+}
+
+void aplicarOperacaoLista(void* contexto, int op, const void* dados, size_t tamanho) {
+    MochilaLista* m = (MochilaLista*)contexto;
+    char nome[30];
+    if (op == WAL_OP_INSERIR && tamanho == sizeof(Item)) {
+        adicionarItemLista(m, (const Item*)dados);
+    } else if (op == WAL_OP_REMOVER && tamanho > 0) {
+        nomeDoLog(nome, dados, tamanho);
+        retirarItemLista(m, nome);
+    }
+}
+
+// A lista vira um vetor na ordem atual (roda no processo filho)
+int gravarSnapshotLista(void* contexto, const char* caminho, uint64_t sequencia) {
+    MochilaLista* m = (MochilaLista*)contexto;
+    Item* itens = (Item*)malloc((size_t)(m->pool.emUso > 0 ? m->pool.emUso : 1) * sizeof(Item));
+    if (itens == NULL) return 0;
+    int n = 0;
+    for (No* p = m->inicio; p != NULL; p = p->proximo) itens[n++] = p->dados;
+    int ok = snapshot_gravar(caminho, "ITEM", itens, sizeof(Item), n, 0, sequencia);
+    free(itens);
+    return ok;
+}
+
+int abrirLogLista(MochilaLista* m, const char* base) {
+    char caminhoSnap[512], caminhoLog[512];
+    snprintf(caminhoSnap, sizeof(caminhoSnap), "%s.lista.snap", base);
+    snprintf(caminhoLog, sizeof(caminhoLog), "%s.lista.log", base);
+
+    uint64_t sequencia = 0;
+    if (arquivoExiste(caminhoSnap)) {
+        Snapshot snap;
+        if (!snapshot_carregar(&snap, caminhoSnap, "ITEM", sizeof(Item))) return 0;
+        // inserir no início inverte: do último para o primeiro mantém a ordem
+        const Item* itens = (const Item*)snap.registros;
+        for (int i = snap.quantidade - 1; i >= 0; i--) adicionarItemLista(m, &itens[i]);
+        sequencia = snap.sequencia;
+        snapshot_liberar(&snap);
+    }
+
+    Wal log;
+    if (wal_abrir(&log, caminhoLog, "ITEM", sequencia, aplicarOperacaoLista, m) < 0) return 0;
+    wal_definirCompactacao(&log, caminhoSnap, WAL_LIMITE_COMPACTACAO, gravarSnapshotLista, m);
+    m->log = log;
+    return 1;
+}
+
+
+// ============================================
+// FUNÇÕES DA LISTA DESENROLADA
+// ============================================
+
+void iniciarMochilaDesenrolada(MochilaDesenrolada* m) {
+    pool_iniciar(&m->pool, sizeof(BlocoItens));
+    m->inicio = m->fim = NULL;
+    m->tamanho = 0;
+}
+
+void liberarMochilaDesenrolada(MochilaDesenrolada* m) {
+    pool_liberar(&m->pool);
+    m->inicio = m->fim = NULL;
+    m->tamanho = 0;
+}
+
+// Anexa o item no último bloco; abre um bloco novo quando ele está cheio
+void adicionarItemDesenrolada(MochilaDesenrolada* m, const Item* item) {
+    Medicao med = medicao_iniciar();
+    if (m->fim == NULL || m->fim->quantidade == ITENS_POR_BLOCO) {
+        BlocoItens* novo = (BlocoItens*)pool_alocar(&m->pool);
+        novo->quantidade = 0;
+        novo->proximo = NULL;
+        if (m->fim == NULL) m->inicio = novo;
+        else m->fim->proximo = novo;
+        m->fim = novo;
+    }
+    m->fim->itens[m->fim->quantidade++] = *item;
+    m->tamanho++;
+    medicao_registrar(&med, &estatisticasMochila[EST_DESENROLADA_INSERCAO]);
+}
+
+// Remove o primeiro item com o nome, fechando o buraco dentro do bloco.
+// Um bloco que fica com menos da metade absorve o seguinte se couber,
+// para a lista não degenerar em blocos quase vazios.
+int retirarItemDesenrolada(MochilaDesenrolada* m, const char* nome) {
+    Medicao med = medicao_iniciar();
+    BlocoItens *bloco = m->inicio, *anterior = NULL;
+    int removeu = 0;
+    ChaveBusca k;
+    chave_preparar(&k, nome, TAM_NOME_ITEM);
+
+    while (bloco != NULL && !removeu) {
+        int i = chave_procurar(bloco->itens[0].nome, sizeof(Item), bloco->quantidade, &k);
+        if (i >= 0) {
+            memmove(&bloco->itens[i], &bloco->itens[i + 1],
+                    (size_t)(bloco->quantidade - i - 1) * sizeof(Item));
+            bloco->quantidade--;
+            m->tamanho--;
+            removeu = 1;
+
+            BlocoItens* prox = bloco->proximo;
+            if (bloco->quantidade == 0) {
+                if (anterior == NULL) m->inicio = prox;
+                else anterior->proximo = prox;
+                if (m->fim == bloco) m->fim = anterior;
+                pool_devolver(&m->pool, bloco);
+            } else if (prox != NULL && bloco->quantidade < ITENS_POR_BLOCO / 2 &&
+                       bloco->quantidade + prox->quantidade <= ITENS_POR_BLOCO) {
+                memcpy(&bloco->itens[bloco->quantidade], prox->itens,
+                       (size_t)prox->quantidade * sizeof(Item));
+                bloco->quantidade += prox->quantidade;
+                bloco->proximo = prox->proximo;
+                if (m->fim == prox) m->fim = bloco;
+                pool_devolver(&m->pool, prox);
+            }
+            break;
+        }
+        anterior = bloco;
+        bloco = bloco->proximo;
+    }
+    medicao_registrar(&med, &estatisticasMochila[EST_DESENROLADA_REMOCAO]);
+    return removeu;
+}
+
+void inserirItemDesenrolada(MochilaDesenrolada* m) {
+    Item novo;
+
+    if (!entrada_lerTexto("\nNome do item: ", novo.nome, sizeof(novo.nome))) return;
+    if (!entrada_lerTexto("Tipo: ", novo.tipo, sizeof(novo.tipo))) return;
+    if (!entrada_lerInteiro("Quantidade: ", &novo.quantidade)) return;
+
+    adicionarItemDesenrolada(m, &novo);
+
+    printf("\nItem inserido na lista desenrolada!\n");
+}
+
+void removerItemDesenrolada(MochilaDesenrolada* m) {
+    if (m->tamanho == 0) {
+        printf("\nLista vazia.\n");
+        return;
+    }
+
+    char nome[30];
+    if (!entrada_lerTexto("\nNome do item para remover: ", nome, sizeof(nome))) return;
+
+    if (retirarItemDesenrolada(m, nome))
+        printf("\nItem removido da lista desenrolada!\n");
+    else
+        printf("\nItem não encontrado.\n");
+}
+
+void listarDesenrolada(const MochilaDesenrolada* m) {
+    printf("\n===== Itens na Lista Desenrolada =====\n");
+
+    if (m->tamanho == 0) {
+        printf("Lista vazia.\n");
+        return;
+    }
+
+    for (BlocoItens* b = m->inicio; b != NULL; b = b->proximo)
+        for (int i = 0; i < b->quantidade; i++)
+            escreverLinhaItem(&b->itens[i]);
+    saida_descarregar(&saida_tabela);
+}
+
+// Busca sequencial: percorre os itens de cada bloco em sequência
+Item* buscarSequencialDesenrolada(const MochilaDesenrolada* m, char nome[]) {
+    Medicao med = medicao_iniciar();
+    Item* achou = NULL;
+    comparacoesSequencialDesenrolada = 0;
+
+    ChaveBusca k;
+    chave_preparar(&k, nome, TAM_NOME_ITEM);
+
+    // cada bloco é uma varredura contígua sobre os campos de nome
+    for (BlocoItens* b = m->inicio; b != NULL && achou == NULL; b = b->proximo) {
+        int i = chave_procurar(b->itens[0].nome, sizeof(Item), b->quantidade, &k);
+        comparacoesSequencialDesenrolada += i < 0 ? b->quantidade : i + 1;
+        if (i >= 0) achou = &b->itens[i];
+    }
+    medicao_registrar(&med, &estatisticasMochila[EST_DESENROLADA_BUSCA_SEQ]);
+    return achou;
+}
+
+
+// ============================================
+// FUNÇÕES DA ÁRVORE B
+// ============================================
+
+// Ordem total (nome, tipo, quantidade), exigida pela árvore
+int compararItemCompleto(const void* a, const void* b) {
+    const Item *x = (const Item*)a, *y = (const Item*)b;
+    int c = chave_comparar(x->nome, y->nome, TAM_NOME_ITEM);
+    if (c == 0) c = chave_comparar(x->tipo, y->tipo, TAM_TIPO_ITEM);
+    if (c == 0) c = (x->quantidade > y->quantidade) - (x->quantidade < y->quantidade);
+    return c;
+}
+
+void iniciarMochilaArvore(MochilaArvore* m) {
+    arvoreb_iniciar(&m->arvore, sizeof(Item), compararItemCompleto);
+}
+
+void liberarMochilaArvore(MochilaArvore* m) {
+    arvoreb_liberar(&m->arvore);
+}
+
+void adicionarItemArvore(MochilaArvore* m, const Item* item) {
+    Medicao med = medicao_iniciar();
+    arvoreb_inserir(&m->arvore, item);
+    medicao_registrar(&med, &estatisticasMochila[EST_ARVORE_INSERCAO]);
+}
+
+// Primeiro item com o nome (menor tipo/quantidade), ou NULL.
+// A sonda tem o nome e os demais campos no mínimo.
+Item* buscarItemArvore(MochilaArvore* m, const char* nome) {
+    Medicao med = medicao_iniciar();
+    Item sonda;
+    memset(&sonda, 0, sizeof(sonda));
+    strncat(sonda.nome, nome, sizeof(sonda.nome) - 1);
+    sonda.quantidade = -2147483647 - 1;
+
+    m->arvore.comparacoes = 0;
+    Item* achado = (Item*)arvoreb_limiteInferior(&m->arvore, &sonda);
+    if (achado != NULL && strcmp(achado->nome, nome) != 0) achado = NULL;
+    comparacoesArvore = (int)m->arvore.comparacoes;
+    medicao_registrar(&med, &estatisticasMochila[EST_ARVORE_BUSCA]);
+    return achado;
+}
+
+int retirarItemArvore(MochilaArvore* m, const char* nome) {
+    Medicao med = medicao_iniciar();
+    Item* achado = buscarItemArvore(m, nome);
+    int removeu = 0;
+    if (achado != NULL) {
+        Item alvo = *achado; // o nó muda durante a remoção
+        removeu = arvoreb_remover(&m->arvore, &alvo, NULL);
+    }
+    medicao_registrar(&med, &estatisticasMochila[EST_ARVORE_REMOCAO]);
+    return removeu;
+}
+
+void inserirItemArvore(MochilaArvore* m) {
+    Item novo;
+    memset(&novo, 0, sizeof(novo));
+
+    if (!entrada_lerTexto("\nNome do item: ", novo.nome, sizeof(novo.nome))) return;
+    if (!entrada_lerTexto("Tipo: ", novo.tipo, sizeof(novo.tipo))) return;
+    if (!entrada_lerInteiro("Quantidade: ", &novo.quantidade)) return;
+
+    adicionarItemArvore(m, &novo);
+
+    printf("\nItem inserido na árvore!\n");
+}
+
+void removerItemArvore(MochilaArvore* m) {
+    if (m->arvore.tamanho == 0) {
+        printf("\nÁrvore vazia.\n");
+        return;
+    }
+
+    char nome[30];
+    if (!entrada_lerTexto("\nNome do item para remover: ", nome, sizeof(nome))) return;
+
+    if (retirarItemArvore(m, nome))
+        printf("\nItem removido da árvore!\n");
+    else
+        printf("\nItem não encontrado.\n");
+}
+
+// Visitante de listagem; 'contexto', se não for NULL, conta os itens
+int listarVisitadoArvore(const void* registro, void* contexto) {
+    escreverLinhaItem((const Item*)registro);
+    if (contexto != NULL) (*(int*)contexto)++;
+    return 1;
+}
+
+// Visita, em ordem de nome, os itens cujo nome começa com 'prefixo': a
+// faixa da árvore entre uma sonda com o prefixo e os demais campos no
+// mínimo e outra com o prefixo seguido de bytes 0xFF. Conta as comparações
+// em comparacoesPrefixo.
+void buscarPrefixoArvore(MochilaArvore* m, const char* prefixo, VisitaRegistro visita, void* contexto) {
+    Medicao med = medicao_iniciar();
+    Item de, ate;
+    size_t len = strlen(prefixo);
+    if (len > TAM_NOME_ITEM - 1) len = TAM_NOME_ITEM - 1;
+    memset(&de, 0, sizeof(de));
+    memcpy(de.nome, prefixo, len);
+    de.quantidade = -2147483647 - 1;
+    memset(&ate, 0xFF, sizeof(ate));
+    memcpy(ate.nome, prefixo, len);
+    ate.nome[TAM_NOME_ITEM - 1] = '\0';
+    ate.tipo[TAM_TIPO_ITEM - 1] = '\0';
+    ate.quantidade = 2147483647;
+
+    m->arvore.comparacoes = 0;
+    arvoreb_intervalo(&m->arvore, &de, &ate, visita, contexto);
+    comparacoesPrefixo = (int)m->arvore.comparacoes;
+    medicao_registrar(&med, &estatisticasMochila[EST_ARVORE_BUSCA_PREFIXO]);
+}
+
+// Lista em ordem de nome (percurso em ordem, sem ordenar)
+void listarArvore(MochilaArvore* m) {
+    printf("\n===== Itens na Árvore B (altura %d) =====\n", arvoreb_altura(&m->arvore));
+
+    if (m->arvore.tamanho == 0) {
+        printf("Árvore vazia.\n");
+        return;
+    }
+    arvoreb_intervalo(&m->arvore, NULL, NULL, listarVisitadoArvore, NULL);
+    saida_descarregar(&saida_tabela);
 }
 
 
@@ -246,41 +988,51 @@ No* buscarSequencialLista(No* lista, char nome[]) {
 // ============================================
 
 void menuVetor() {
-    Item vetor[MAX_ITENS];
-    int tamanho = 0;
+    MochilaVetor vetor;
     int op;
     char nomeBusca[30];
 
+    iniciarMochilaVetor(&vetor);
+    if (baseWal != NULL && !abrirLogVetor(&vetor, baseWal)) {
+        liberarMochilaVetor(&vetor);
+        return;
+    }
+
     do {
         printf("\n===== MENU VETOR =====\n");
         printf("1 - Inserir\n");
         printf("2 - Remover\n");
         printf("3 - Listar\n");
         printf("4 - Busca Sequencial\n");
-        printf("5 - Ordenar\n");
+        printf("5 - Ordenar (e manter a ordem nas inserções)\n");
         printf("6 - Busca Binária\n");
+        printf("7 - Busca por Hash\n");
+        printf("8 - Salvar snapshot binário\n");
+        printf("9 - Carregar snapshot binário\n");
+        printf("10 - Busca por começo do nome (autocompletar)\n");
         printf("0 - Voltar\n");
-        printf("Escolha: ");
-        scanf("%d", &op);
+        entrada_lerInteiro("Escolha: ", &op);
+
+        Item* itens = (Item*)vetor.itens.dados;
+        int tamanho = vetor.itens.tamanho;
 
         switch (op) {
             case 1:
-                inserirItemVetor(vetor, &tamanho);
+                inserirItemVetor(&vetor);
                 break;
 
             case 2:
-                removerItemVetor(vetor, &tamanho);
+                removerItemVetor(&vetor);
                 break;
 
             case 3:
-                listarVetor(vetor, tamanho);
+                listarVetor(itens, tamanho);
                 break;
 
             case 4:
-                printf("\nNome para buscar: ");
-                scanf("%s", nomeBusca);
+                entrada_lerTexto("\nNome para buscar: ", nomeBusca, sizeof(nomeBusca));
                 int pos;
-                pos = buscarSequencialVetor(vetor, tamanho, nomeBusca);
+                pos = buscarSequencialVetor(itens, tamanho, nomeBusca);
                 if (pos >= 0)
                     printf("\nItem encontrado no índice %d\n", pos);
                 else
@@ -289,39 +1041,95 @@ void menuVetor() {
                 break;
 
             case 5:
-                ordenarVetor(vetor, tamanho);
+                ordenarMochilaVetor(&vetor);
+                wal_sincronizar(&vetor.log);
+                printf("\nVetor ordenado por nome!\n");
                 break;
 
             case 6:
-                printf("\nNome para buscar: ");
-                scanf("%s", nomeBusca);
-                int p = buscarBinariaVetor(vetor, tamanho, nomeBusca);
+                if (!vetor.ordenado) {
+                    printf("\nA busca binária exige o vetor ordenado (opção 5).\n");
+                    break;
+                }
+                entrada_lerTexto("\nNome para buscar: ", nomeBusca, sizeof(nomeBusca));
+                int p = buscarBinariaVetor(itens, tamanho, nomeBusca);
                 if (p >= 0)
                     printf("\nItem encontrado no índice %d\n", p);
                 else
                     printf("\nItem não encontrado.\n");
                 printf("Comparações: %d\n", comparacoesBinaria);
                 break;
+
+            case 7:
+                entrada_lerTexto("\nNome para buscar: ", nomeBusca, sizeof(nomeBusca));
+                int h = buscarHashVetor(&vetor.indice, nomeBusca);
+                if (h >= 0)
+                    printf("\nItem encontrado no índice %d\n", h);
+                else
+                    printf("\nItem não encontrado.\n");
+                printf("Comparações (sondagens): %d\n", comparacoesHash);
+                break;
+
+            case 8:
+            case 9: {
+                char arquivo[256];
+                entrada_lerTexto("\nArquivo do snapshot: ", arquivo, sizeof(arquivo));
+                if (op == 8) {
+                    if (salvarMochilaVetor(&vetor, arquivo))
+                        printf("\n%d itens salvos em '%s'.\n", tamanho, arquivo);
+                } else if (wal_ativo(&vetor.log)) {
+                    printf("\nCom --wal o vetor vem do log; carregar outro snapshot o desfaria.\n");
+                } else {
+                    long long t0 = cronometro_agoraNs();
+                    if (carregarMochilaVetor(&vetor, arquivo))
+                        printf("\n%d itens carregados em %s.\n", vetor.itens.tamanho,
+                               cronometro_texto(cronometro_agoraNs() - t0));
+                }
+                break;
+            }
+
+            case 10: {
+                if (!vetor.ordenado) {
+                    printf("\nA busca por prefixo exige o vetor ordenado (opção 5).\n");
+                    break;
+                }
+                entrada_lerTexto("\nComeço do nome: ", nomeBusca, sizeof(nomeBusca));
+                int inicio;
+                int total = buscarPrefixoVetor(itens, tamanho, nomeBusca, &inicio);
+                for (int i = inicio; i < inicio + total; i++) escreverLinhaItem(&itens[i]);
+                saida_descarregar(&saida_tabela);
+                printf("\n%d item(ns) começam com '%s'.\n", total, nomeBusca);
+                printf("Comparações: %d\n", comparacoesPrefixo);
+                break;
+            }
         }
 
     } while (op != 0);
+
+    liberarMochilaVetor(&vetor);
 }
 
 
 void menuLista() {
-    No* lista = NULL;
+    MochilaLista lista;
     int op;
     char nomeBusca[30];
 
+    iniciarMochilaLista(&lista);
+    if (baseWal != NULL && !abrirLogLista(&lista, baseWal)) {
+        liberarMochilaLista(&lista);
+        return;
+    }
+
     do {
         printf("\n===== MENU LISTA =====\n");
         printf("1 - Inserir\n");
         printf("2 - Remover\n");
         printf("3 - Listar\n");
         printf("4 - Busca Sequencial\n");
+        printf("5 - Busca por Hash\n");
         printf("0 - Voltar\n");
-        printf("Escolha: ");
-        scanf("%d", &op);
+        entrada_lerInteiro("Escolha: ", &op);
 
         switch (op) {
             case 1:
@@ -333,13 +1141,12 @@ void menuLista() {
                 break;
 
             case 3:
-                listarLista(lista);
+                listarLista(lista.inicio);
                 break;
 
             case 4:
-                printf("\nNome para buscar: ");
-                scanf("%s", nomeBusca);
-                No* resultado = buscarSequencialLista(lista, nomeBusca);
+                entrada_lerTexto("\nNome para buscar: ", nomeBusca, sizeof(nomeBusca));
+                No* resultado = buscarSequencialLista(lista.inicio, nomeBusca);
                 if (resultado)
                     printf("\nItem encontrado: %s\n", resultado->dados.nome);
                 else
@@ -347,9 +1154,331 @@ void menuLista() {
 
                 printf("Comparações: %d\n", comparacoesSequencialLista);
                 break;
+
+            case 5:
+                entrada_lerTexto("\nNome para buscar: ", nomeBusca, sizeof(nomeBusca));
+                No* achado = buscarHashLista(&lista, nomeBusca);
+                if (achado)
+                    printf("\nItem encontrado: %s\n", achado->dados.nome);
+                else
+                    printf("\nItem não encontrado.\n");
+
+                printf("Comparações (sondagens): %d\n", comparacoesHashLista);
+                break;
         }
 
     } while (op != 0);
+
+    liberarMochilaLista(&lista);
+}
+
+
+void menuDesenrolada() {
+    MochilaDesenrolada lista;
+    int op;
+    char nomeBusca[30];
+
+    iniciarMochilaDesenrolada(&lista);
+
+    do {
+        printf("\n===== MENU LISTA DESENROLADA =====\n");
+        printf("1 - Inserir\n");
+        printf("2 - Remover\n");
+        printf("3 - Listar\n");
+        printf("4 - Busca Sequencial\n");
+        printf("0 - Voltar\n");
+        entrada_lerInteiro("Escolha: ", &op);
+
+        switch (op) {
+            case 1:
+                inserirItemDesenrolada(&lista);
+                break;
+
+            case 2:
+                removerItemDesenrolada(&lista);
+                break;
+
+            case 3:
+                listarDesenrolada(&lista);
+                break;
+
+            case 4:
+                entrada_lerTexto("\nNome para buscar: ", nomeBusca, sizeof(nomeBusca));
+                Item* resultado = buscarSequencialDesenrolada(&lista, nomeBusca);
+                if (resultado)
+                    printf("\nItem encontrado: %s\n", resultado->nome);
+                else
+                    printf("\nItem não encontrado.\n");
+
+                printf("Comparações: %d\n", comparacoesSequencialDesenrolada);
+                break;
+        }
+
+    } while (op != 0);
+
+    liberarMochilaDesenrolada(&lista);
+}
+
+
+void menuArvore() {
+    MochilaArvore arvore;
+    int op;
+    char nomeBusca[30];
+
+    iniciarMochilaArvore(&arvore);
+
+    do {
+        printf("\n===== MENU ÁRVORE B =====\n");
+        printf("1 - Inserir\n");
+        printf("2 - Remover\n");
+        printf("3 - Listar (em ordem de nome)\n");
+        printf("4 - Buscar por nome\n");
+        printf("5 - Buscar por começo do nome (autocompletar)\n");
+        printf("0 - Voltar\n");
+        entrada_lerInteiro("Escolha: ", &op);
+
+        switch (op) {
+            case 1:
+                inserirItemArvore(&arvore);
+                break;
+
+            case 2:
+                removerItemArvore(&arvore);
+                break;
+
+            case 3:
+                listarArvore(&arvore);
+                break;
+
+            case 4:
+                entrada_lerTexto("\nNome para buscar: ", nomeBusca, sizeof(nomeBusca));
+                Item* resultado = buscarItemArvore(&arvore, nomeBusca);
+                if (resultado)
+                    printf("\nItem encontrado: %s | Tipo: %s | Quantidade: %d\n",
+                           resultado->nome, resultado->tipo, resultado->quantidade);
+                else
+                    printf("\nItem não encontrado.\n");
+
+                printf("Comparações: %d\n", comparacoesArvore);
+                break;
+
+            case 5: {
+                entrada_lerTexto("\nComeço do nome: ", nomeBusca, sizeof(nomeBusca));
+                int total = 0;
+                buscarPrefixoArvore(&arvore, nomeBusca, listarVisitadoArvore, &total);
+                saida_descarregar(&saida_tabela);
+                printf("\n%d item(ns) começam com '%s'.\n", total, nomeBusca);
+                printf("Comparações: %d\n", comparacoesPrefixo);
+                break;
+            }
+        }
+
+    } while (op != 0);
+
+    liberarMochilaArvore(&arvore);
+}
+
+
+// Pontos de entrada (lote e main) ficam de fora quando este arquivo é
+// incluído por outro programa, como o benchmark em ../benchmark.
+#ifndef FREEFIRE_SEM_MAIN
+
+// ============================================
+// MODO LOTE (--lote [arquivo])
+// ============================================
+
+// Visitante do lote para a árvore: uma linha por item
+int escreverItemVisitado(const void* registro, void* contexto) {
+    const Item* it = (const Item*)registro;
+    printf("%s %s %d\n", it->nome, it->tipo, it->quantidade);
+    if (contexto != NULL) (*(int*)contexto)++;
+    return 1;
+}
+
+// Próximo comando do lote. Os grupos pendentes dos logs vão ao disco
+// quando passam da idade máxima, mesmo que a entrada fique parada.
+char* proximoComandoLote(Lote* lote, Wal* logVetor, Wal* logLista) {
+    wal_sincronizarVencido(logVetor);
+    wal_sincronizarVencido(logLista);
+    long long pv = wal_prazoNs(logVetor), pl = wal_prazoNs(logLista);
+    long long prazo = pv < 0 ? pl : (pl < 0 || pv < pl ? pv : pl);
+    if (prazo > 0 && !lote_aguardarComando(lote, prazo)) {
+        wal_sincronizar(logVetor);
+        wal_sincronizar(logLista);
+    }
+    return lote_proximoComando(lote);
+}
+
+// Estrutura ativa no modo lote
+typedef enum { USANDO_VETOR, USANDO_LISTA, USANDO_DESENROLADA, USANDO_ARVORE } EstruturaLote;
+
+// Comandos, um por linha (valem para a estrutura ativa):
+//   u vetor|lista|desenrolada|arvore  escolhe a estrutura (padrão: vetor)
+//   i <nome> <tipo> <quantidade>   inserir
+//   r <nome>                       remover
+//   b <nome>                       busca sequencial (na árvore: busca na árvore)
+//   bb <nome>                      busca binária (vetor ordenado)
+//   h <nome>                       busca por hash (vetor ou lista)
+//   bp <prefixo>                   nomes que começam com o prefixo (vetor
+//                                  ordenado ou árvore)
+//   o                              ordenar por nome (vetor); as inserções
+//                                  seguintes entram já na posição certa
+//   salvar <arquivo>               gravar snapshot binário (vetor)
+//   carregar <arquivo>             carregar snapshot binário (vetor)
+//   l                              listar
+// Com --wal, vetor e lista partem do estado salvo e registram cada
+// operação (commit em grupo). Retorna 0 se o estado salvo for inválido.
+int executarLote(Lote* lote) {
+    MochilaVetor vetor;
+    MochilaLista lista;
+    MochilaDesenrolada desenrolada;
+    MochilaArvore arvore;
+    EstruturaLote usando = USANDO_VETOR;
+    char* cmd;
+    char nome[30];
+
+    iniciarMochilaVetor(&vetor);
+    iniciarMochilaLista(&lista);
+    iniciarMochilaDesenrolada(&desenrolada);
+    iniciarMochilaArvore(&arvore);
+
+    int ok = baseWal == NULL || (abrirLogVetor(&vetor, baseWal) && abrirLogLista(&lista, baseWal));
+
+    while (ok && (cmd = proximoComandoLote(lote, &vetor.log, &lista.log)) != NULL) {
+        Item* itens = (Item*)vetor.itens.dados;
+        int tamanho = vetor.itens.tamanho;
+
+        if (strcmp(cmd, "u") == 0) {
+            char* qual = lote_token(lote);
+            if (qual != NULL && strcmp(qual, "vetor") == 0) usando = USANDO_VETOR;
+            else if (qual != NULL && strcmp(qual, "lista") == 0) usando = USANDO_LISTA;
+            else if (qual != NULL && strcmp(qual, "desenrolada") == 0) usando = USANDO_DESENROLADA;
+            else if (qual != NULL && strcmp(qual, "arvore") == 0) usando = USANDO_ARVORE;
+            else lote_erro(lote, "uso: u vetor|lista|desenrolada|arvore");
+        } else if (strcmp(cmd, "i") == 0) {
+            Item novo;
+            memset(&novo, 0, sizeof(novo));
+            if (!lote_texto(lote, novo.nome, sizeof(novo.nome)) ||
+                !lote_texto(lote, novo.tipo, sizeof(novo.tipo)) ||
+                !lote_inteiro(lote, &novo.quantidade)) {
+                lote_erro(lote, "uso: i <nome> <tipo> <quantidade>");
+                continue;
+            }
+            if (usando == USANDO_LISTA) adicionarItemLista(&lista, &novo);
+            else if (usando == USANDO_DESENROLADA) adicionarItemDesenrolada(&desenrolada, &novo);
+            else if (usando == USANDO_ARVORE) adicionarItemArvore(&arvore, &novo);
+            else adicionarItemVetor(&vetor, &novo);
+            printf("inserido %s\n", novo.nome);
+        } else if (strcmp(cmd, "l") == 0) {
+            if (usando == USANDO_LISTA) {
+                for (No* p = lista.inicio; p != NULL; p = p->proximo)
+                    printf("%s %s %d\n", p->dados.nome, p->dados.tipo, p->dados.quantidade);
+            } else if (usando == USANDO_DESENROLADA) {
+                printf("total %d\n", desenrolada.tamanho);
+                for (BlocoItens* b = desenrolada.inicio; b != NULL; b = b->proximo)
+                    for (int i = 0; i < b->quantidade; i++)
+                        printf("%s %s %d\n", b->itens[i].nome, b->itens[i].tipo, b->itens[i].quantidade);
+            } else if (usando == USANDO_ARVORE) {
+                printf("total %d\n", arvore.arvore.tamanho);
+                arvoreb_intervalo(&arvore.arvore, NULL, NULL, escreverItemVisitado, NULL);
+            } else {
+                printf("total %d\n", tamanho);
+                for (int i = 0; i < tamanho; i++)
+                    printf("%s %s %d\n", itens[i].nome, itens[i].tipo, itens[i].quantidade);
+            }
+        } else if (strcmp(cmd, "o") == 0) {
+            if (usando != USANDO_VETOR) { lote_erro(lote, "ordenação só no vetor"); continue; }
+            ordenarMochilaVetor(&vetor);
+            printf("ordenado %d\n", tamanho);
+        } else if (strcmp(cmd, "salvar") == 0 || strcmp(cmd, "carregar") == 0) {
+            char* arquivo = lote_token(lote);
+            if (arquivo == NULL) { lote_erro(lote, "falta o arquivo"); continue; }
+            if (usando != USANDO_VETOR) { lote_erro(lote, "snapshot só no vetor"); continue; }
+            if (cmd[0] == 's') {
+                if (salvarMochilaVetor(&vetor, arquivo)) printf("salvo %d\n", tamanho);
+                else lote_erro(lote, "não foi possível salvar");
+            } else if (wal_ativo(&vetor.log)) {
+                lote_erro(lote, "com --wal o vetor vem do log");
+            } else {
+                if (carregarMochilaVetor(&vetor, arquivo)) printf("carregado %d\n", vetor.itens.tamanho);
+                else lote_erro(lote, "snapshot inválido");
+            }
+        } else if (strcmp(cmd, "bp") == 0) {
+            if (!lote_texto(lote, nome, sizeof(nome))) { lote_erro(lote, "falta o prefixo"); continue; }
+            int total = 0;
+            if (usando == USANDO_ARVORE) {
+                buscarPrefixoArvore(&arvore, nome, escreverItemVisitado, &total);
+            } else if (usando == USANDO_VETOR && vetor.ordenado) {
+                int inicio;
+                total = buscarPrefixoVetor(itens, tamanho, nome, &inicio);
+                for (int i = inicio; i < inicio + total; i++) escreverItemVisitado(&itens[i], NULL);
+            } else {
+                lote_erro(lote, "busca por prefixo só no vetor ordenado (o) ou na árvore");
+                continue;
+            }
+            printf("prefixo %d comparacoes=%d\n", total, comparacoesPrefixo);
+        } else if (strcmp(cmd, "r") == 0 || strcmp(cmd, "b") == 0 ||
+                   strcmp(cmd, "bb") == 0 || strcmp(cmd, "h") == 0) {
+            if (!lote_texto(lote, nome, sizeof(nome))) { lote_erro(lote, "falta o nome"); continue; }
+
+            if (cmd[0] == 'r') {
+                int ok;
+                if (usando == USANDO_LISTA) ok = retirarItemLista(&lista, nome);
+                else if (usando == USANDO_DESENROLADA) ok = retirarItemDesenrolada(&desenrolada, nome);
+                else if (usando == USANDO_ARVORE) ok = retirarItemArvore(&arvore, nome);
+                else ok = retirarItemVetor(&vetor, nome);
+                printf("%s %s\n", ok ? "removido" : "nao_encontrado", nome);
+            } else if (usando != USANDO_VETOR) {
+                int hashLista = cmd[0] == 'h' && usando == USANDO_LISTA;
+                if (!hashLista && (cmd[0] != 'b' || cmd[1] != '\0')) {
+                    lote_erro(lote, "nesta estrutura só há busca sequencial (b)");
+                    continue;
+                }
+                int achou, comps;
+                if (hashLista) {
+                    achou = buscarHashLista(&lista, nome) != NULL;
+                    comps = comparacoesHashLista;
+                } else if (usando == USANDO_LISTA) {
+                    achou = buscarSequencialLista(lista.inicio, nome) != NULL;
+                    comps = comparacoesSequencialLista;
+                } else if (usando == USANDO_ARVORE) {
+                    achou = buscarItemArvore(&arvore, nome) != NULL;
+                    comps = comparacoesArvore;
+                } else {
+                    achou = buscarSequencialDesenrolada(&desenrolada, nome) != NULL;
+                    comps = comparacoesSequencialDesenrolada;
+                }
+                if (achou) printf("encontrado %s comparacoes=%d\n", nome, comps);
+                else printf("nao_encontrado %s comparacoes=%d\n", nome, comps);
+            } else {
+                int pos, comps;
+                if (cmd[1] == 'b' && !vetor.ordenado) {
+                    lote_erro(lote, "busca binária exige ordenação (o)");
+                    continue;
+                }
+                if (cmd[0] == 'h') {
+                    pos = buscarHashVetor(&vetor.indice, nome);
+                    comps = comparacoesHash;
+                } else if (cmd[1] == 'b') {
+                    pos = buscarBinariaVetor(itens, tamanho, nome);
+                    comps = comparacoesBinaria;
+                } else {
+                    pos = buscarSequencialVetor(itens, tamanho, nome);
+                    comps = comparacoesSequencialVetor;
+                }
+                if (pos >= 0) printf("encontrado %s %d comparacoes=%d\n", nome, pos, comps);
+                else printf("nao_encontrado %s comparacoes=%d\n", nome, comps);
+            }
+        } else {
+            lote_erro(lote, "comando desconhecido");
+        }
+    }
+
+    liberarMochilaArvore(&arvore);
+    liberarMochilaDesenrolada(&desenrolada);
+    liberarMochilaLista(&lista);
+    liberarMochilaVetor(&vetor);
+    return ok;
 }
 
 
@@ -357,16 +1486,29 @@ void menuLista() {
 // MAIN
 // ============================================
 
-int main() {
+int main(int argc, char* argv[]) {
     int op;
 
+    iniciarEstatisticasMochila();
+    baseWal = wal_argumento(argc, argv); // --wal <base>: vetor e lista persistentes
+
+    if (lote_solicitado(argc, argv)) {
+        Lote lote;
+        if (!lote_abrir(&lote, argc, argv)) return 1;
+        int ok = executarLote(&lote);
+        lote_fechar(&lote);
+        return ok ? 0 : 1;
+    }
+
     do {
         printf("\n===== SISTEMA DE MOCHILA =====\n");
         printf("1 - Usar Vetor\n");
         printf("2 - Usar Lista Encadeada\n");
+        printf("3 - Usar Lista Desenrolada (vários itens por nó)\n");
+        printf("4 - Usar Árvore B (ordenada por nome)\n");
+        printf("5 - Estatísticas de desempenho\n");
         printf("0 - Sair\n");
-        printf("Escolha: ");
-        scanf("%d", &op);
+        entrada_lerInteiro("Escolha: ", &op); // fim da entrada vale 0: submenus voltam e o programa sai
 
         switch (op) {
             case 1:
@@ -377,6 +1519,18 @@ int main() {
                 menuLista();
                 break;
 
+            case 3:
+                menuDesenrolada();
+                break;
+
+            case 4:
+                menuArvore();
+                break;
+
+            case 5:
+                mostrarEstatisticasMochila();
+                break;
+
             case 0:
                 printf("\nSaindo...\n");
                 break;
@@ -389,3 +1543,5 @@ int main() {
 
     return 0;
 }
+
+#endif // FREEFIRE_SEM_MAIN
@@ -0,0 +1,639 @@
+/* benchmark.c
+ *
+ * Bancada de testes reprodutível para as ordenações e buscas dos níveis
+ * Mestre e Aventureiro. Gera inventários sintéticos de tamanho e
+ * distribuição configuráveis, roda cada algoritmo com aquecimento e
+ * repetições e escreve CSV com tempo mínimo, mediano e p99 (ns) e o
+ * número de comparações (ou movimentações, nas ordenações lineares). O
+ * armazém preenche a coluna 'operacoes' e o estresse de leitura a
+ * 'escritas_por_s'; em cada linha as colunas que não se aplicam ficam vazias.
+ * O relógio é o de ../comum/cronometro.h; a instrumentação interna dos
+ * níveis fica desligada para não somar custo às medições.
+ *
+ * Compile:
+ *   gcc -O2 benchmark.c -o benchmark -pthread
+ * Execute:
+ *   ./benchmark [opções] > resultados.csv
+ *
+ * Opções:
+ *   --tamanhos 100,1000,...     tamanhos dos inventários (1e2..1e7)
+ *   --distribuicoes lista       aleatoria,ordenada,inversa,duplicadas (padrão: todas)
+ *   --repeticoes R              medições por caso (padrão 5)
+ *   --aquecimento W             execuções descartadas antes (padrão 1)
+ *   --max-quadratico N          pula ordenações O(n^2) acima de N (padrão 20000)
+ *   --consultas Q               buscas por medição (padrão 1000)
+ *   --semente S                 semente do gerador (padrão 42)
+ *   --threads T                 threads do Merge Sort paralelo e máximo do armazém (padrão: todos os núcleos)
+ *   --jogadores J               mede o armazém de mochilas (../comum/armazem.h) com J
+ *                               jogadores, de 1 a T threads (padrão 0: não mede)
+ *   --leitores R                estresse de leitura sem trava (../comum/versoes.h): R
+ *                               threads buscando enquanto uma escreve a taxas
+ *                               crescentes, contra as mesmas buscas com trava (padrão 0)
+ *   --saida arquivo.csv         grava em arquivo em vez de stdout
+ */
+
+#define FREEFIRE_SEM_MAIN
+#include "../mestre/FreeFire.c"
+#include "../aventureiro/FreeFire.c"
+#include "../comum/armazem.h"
+#include "../comum/versoes.h"
+
+#include <stdint.h>
+#include <time.h>
+
+#define MAX_TAMANHOS 16
+
+typedef enum {
+    DIST_ALEATORIA,
+    DIST_ORDENADA,
+    DIST_INVERSA,
+    DIST_DUPLICADAS,
+    NUM_DISTRIBUICOES
+} Distribuicao;
+
+const char *nomesDistribuicao[NUM_DISTRIBUICOES] = { "aleatoria", "ordenada", "inversa", "duplicadas" };
+
+const char *tiposSinteticos[] = { "arma", "cura", "energia", "estrutura", "eletronico", "municao", "suporte", "propulsao" };
+#define NUM_TIPOS_SINTETICOS 8
+
+typedef struct {
+    int tamanhos[MAX_TAMANHOS];
+    int numTamanhos;
+    int distribuicoes[NUM_DISTRIBUICOES];
+    int repeticoes;
+    int aquecimento;
+    int maxQuadratico;
+    int consultas;
+    int jogadores;
+    int leitores;
+    uint64_t semente;
+    FILE *saida;
+} Config;
+
+// -----------------------------
+// Gerador pseudoaleatório (xorshift64*) para resultados reprodutíveis
+// -----------------------------
+uint64_t estadoAleatorio;
+
+uint64_t aleatorio(void) {
+    estadoAleatorio ^= estadoAleatorio >> 12;
+    estadoAleatorio ^= estadoAleatorio << 25;
+    estadoAleatorio ^= estadoAleatorio >> 27;
+    return estadoAleatorio * 2685821657736338717ULL;
+}
+
+// -----------------------------
+// Geração do inventário sintético
+// A chave k de cada registro define nome, tipo e prioridade, de modo que
+// "ordenada" e "inversa" valem para todos os critérios ao mesmo tempo.
+// -----------------------------
+void gerarComponentes(Componente *arr, int n, Distribuicao dist) {
+    for (int i = 0; i < n; i++) {
+        int k;
+        switch (dist) {
+            case DIST_ORDENADA:   k = i; break;
+            case DIST_INVERSA:    k = n - 1 - i; break;
+            case DIST_DUPLICADAS: k = (int)((long)(aleatorio() % 16) * n / 16); break; // 16 valores, todos < n
+            default:              k = i; break;
+        }
+        memset(&arr[i], 0, sizeof(Componente));
+        snprintf(arr[i].nome, STRLEN, "C%09d", k);
+        long faixa = (long)k * NUM_TIPOS_SINTETICOS / (n + 1);
+        arr[i].tipo = (uint16_t)internarTipo(tiposSinteticos[faixa]);
+        arr[i].prioridade = 1 + (int)((long)k * 10 / (n + 1));
+        arr[i].quantidade = dist == DIST_ALEATORIA ? (int)(aleatorio() % 1000000) : k;
+    }
+    if (dist == DIST_ALEATORIA) {
+        // embaralhamento de Fisher-Yates
+        for (int i = n - 1; i > 0; i--) {
+            int j = (int)(aleatorio() % (uint64_t)(i + 1));
+            Componente t = arr[i]; arr[i] = arr[j]; arr[j] = t;
+        }
+    }
+}
+
+void componentesParaItens(const Componente *src, Item *dst, int n) {
+    for (int i = 0; i < n; i++) {
+        memset(&dst[i], 0, sizeof(Item));
+        memcpy(dst[i].nome, src[i].nome, sizeof(dst[i].nome));
+        strncpy(dst[i].tipo, textoTipo(src[i].tipo), sizeof(dst[i].tipo) - 1);
+        dst[i].quantidade = src[i].quantidade;
+    }
+}
+
+// Nomes para as buscas: metade existentes, metade ausentes
+void gerarConsultas(const Componente *arr, int n, char (*consultas)[STRLEN], int q) {
+    for (int i = 0; i < q; i++) {
+        if (i % 2 == 0 && n > 0) {
+            memcpy(consultas[i], arr[aleatorio() % (uint64_t)n].nome, STRLEN);
+        } else {
+            memset(consultas[i], 0, STRLEN);
+            snprintf(consultas[i], STRLEN, "X%09d", (int)(aleatorio() % 1000000000));
+        }
+    }
+}
+
+// -----------------------------
+// Estatísticas das amostras
+// -----------------------------
+int compararLongLong(const void *a, const void *b) {
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+// Colunas de medida: cada linha preenche só a que mede e deixa as outras
+// vazias (valor negativo)
+#define CABECALHO_CSV "operacao,distribuicao,n,repeticoes,min_ns,mediana_ns,p99_ns,comparacoes,operacoes,escritas_por_s"
+
+void escreverMedida(FILE *saida, double valor) {
+    if (valor < 0) fputc(',', saida);
+    else fprintf(saida, ",%.1f", valor);
+}
+
+void escreverLinhaMedidas(Config *cfg, const char *operacao, Distribuicao dist, int n, long long *amostras, int r,
+                          double comparacoes, double operacoes, double escritasPorSegundo) {
+    qsort(amostras, (size_t)r, sizeof(long long), compararLongLong);
+    int ip99 = (int)((99L * r + 99) / 100) - 1; // ceil(0.99 r) - 1
+    if (ip99 < 0) ip99 = 0;
+    fprintf(cfg->saida, "%s,%s,%d,%d,%lld,%lld,%lld", operacao, nomesDistribuicao[dist], n, r,
+            amostras[0], amostras[r / 2], amostras[ip99]);
+    escreverMedida(cfg->saida, comparacoes);
+    escreverMedida(cfg->saida, operacoes);
+    escreverMedida(cfg->saida, escritasPorSegundo);
+    fputc('\n', cfg->saida);
+    fflush(cfg->saida);
+}
+
+// Linha de ordenação ou busca: só a coluna de comparações
+void escreverLinha(Config *cfg, const char *operacao, Distribuicao dist, int n,
+                   long long *amostras, int r, double comparacoes) {
+    escreverLinhaMedidas(cfg, operacao, dist, n, amostras, r, comparacoes, -1, -1);
+}
+
+// -----------------------------
+// Casos de ordenação: todos os algoritmos da tabela do Mestre, no vetor de
+// Componente e no layout colunar (com a transposição dentro da medição)
+// -----------------------------
+void medirOrdenacoes(Config *cfg, const Componente *base, int n, Distribuicao dist, long long *amostras) {
+    Componente *copia = ordenacao_alocar((size_t)n * sizeof(Componente));
+
+    for (int a = 0; a < NUM_ALGORITMOS; a++) {
+        if (a < NUM_BASELINE && n > cfg->maxQuadratico) continue;
+        long comps = 0;
+        for (int w = 0; w < cfg->aquecimento; w++) {
+            memcpy(copia, base, (size_t)n * sizeof(Componente));
+            algoritmos[a].alg(copia, n, &comps);
+        }
+        for (int r = 0; r < cfg->repeticoes; r++) {
+            memcpy(copia, base, (size_t)n * sizeof(Componente));
+            long long t0 = cronometro_agoraNs();
+            algoritmos[a].alg(copia, n, &comps);
+            amostras[r] = cronometro_agoraNs() - t0;
+        }
+        escreverLinha(cfg, algoritmos[a].nome, dist, n, amostras, cfg->repeticoes, (double)comps);
+    }
+
+    // As colunas são uma cópia derivada: o tempo inclui transpor o vetor para
+    // elas e reescrevê-lo na ordem obtida, para comparar com o mesmo
+    // resultado final dos algoritmos acima
+    ColunasComponentes colunas;
+    iniciarColunas(&colunas);
+    for (int a = 0; a < NUM_ALGORITMOS_COLUNAS; a++) {
+        long comps = 0;
+        for (int w = 0; w < cfg->aquecimento; w++) {
+            memcpy(copia, base, (size_t)n * sizeof(Componente));
+            carregarColunas(&colunas, copia, n);
+            algoritmosColunas[a].alg(&colunas, &comps);
+            exportarColunas(&colunas, copia);
+        }
+        for (int r = 0; r < cfg->repeticoes; r++) {
+            memcpy(copia, base, (size_t)n * sizeof(Componente));
+            long long t0 = cronometro_agoraNs();
+            carregarColunas(&colunas, copia, n);
+            algoritmosColunas[a].alg(&colunas, &comps);
+            exportarColunas(&colunas, copia);
+            amostras[r] = cronometro_agoraNs() - t0;
+        }
+        escreverLinha(cfg, algoritmosColunas[a].nome, dist, n, amostras, cfg->repeticoes, (double)comps);
+    }
+    liberarColunas(&colunas);
+    free(copia);
+}
+
+// -----------------------------
+// Casos de busca: tempo e comparações médios por consulta
+// -----------------------------
+void medirBuscas(Config *cfg, const Componente *base, int n, Distribuicao dist, long long *amostras) {
+    Componente *ordenado = ordenacao_alocar((size_t)n * sizeof(Componente));
+    Item *itens = ordenacao_alocar((size_t)n * sizeof(Item));
+    Item *itensOrdenados = ordenacao_alocar((size_t)n * sizeof(Item));
+    char (*consultas)[STRLEN] = ordenacao_alocar((size_t)cfg->consultas * STRLEN);
+
+    long dummy;
+    memcpy(ordenado, base, (size_t)n * sizeof(Componente));
+    mergeSortNome(ordenado, n, &dummy);
+    componentesParaItens(base, itens, n);
+    componentesParaItens(ordenado, itensOrdenados, n);
+    // cópia colunar montada uma vez, como o índice hash abaixo: o custo por
+    // consulta não inclui a transposição (ela aparece nas linhas de ordenação)
+    ColunasComponentes colunas;
+    iniciarColunas(&colunas);
+    carregarColunas(&colunas, ordenado, n);
+    gerarConsultas(base, n, consultas, cfg->consultas);
+
+    // índice hash sobre os itens na ordem original
+    Inventario inv = { NULL, (char *)itens, n, n, sizeof(Item) };
+    IndiceNome indice;
+    indice_iniciar(&indice, &inv, offsetof(Item, nome));
+    indice_reconstruir(&indice);
+
+    // as mesmas consultas na lista encadeada (sequencial e hash) e na desenrolada
+    MochilaLista lista;
+    MochilaDesenrolada desenrolada;
+    iniciarMochilaLista(&lista);
+    iniciarMochilaDesenrolada(&desenrolada);
+    for (int i = n - 1; i >= 0; i--) adicionarItemLista(&lista, &itens[i]); // mesma ordem do vetor
+    for (int i = 0; i < n; i++) adicionarItemDesenrolada(&desenrolada, &itens[i]);
+
+    // a busca sequencial é O(n) por consulta: limita o total de passos
+    int qSeq = cfg->consultas;
+    if ((long long)qSeq * n > 50000000LL) qSeq = (int)(50000000LL / (n > 0 ? n : 1));
+    if (qSeq < 1) qSeq = 1;
+
+    for (int caso = 0; caso < 8; caso++) {
+        const char *nome = NULL;
+        int q = (caso == 2 || caso == 5 || caso == 6) ? qSeq : cfg->consultas;
+        double comps = 0;
+        for (int r = -cfg->aquecimento; r < cfg->repeticoes; r++) {
+            long long total = 0;
+            long long t0 = cronometro_agoraNs();
+            for (int i = 0; i < q; i++) {
+                long c = 0;
+                switch (caso) {
+                    case 0:
+                        nome = "buscaBinariaPorNome";
+                        buscaBinariaPorNome(ordenado, n, consultas[i], &c);
+                        break;
+                    case 1:
+                        nome = "buscarBinariaVetor";
+                        buscarBinariaVetor(itensOrdenados, n, consultas[i]);
+                        c = comparacoesBinaria;
+                        break;
+                    case 2:
+                        nome = "buscarSequencialVetor";
+                        buscarSequencialVetor(itens, n, consultas[i]);
+                        c = comparacoesSequencialVetor;
+                        break;
+                    case 3:
+                        nome = "buscaBinariaColunas";
+                        buscaBinariaColunas(&colunas, consultas[i], &c);
+                        break;
+                    case 4:
+                        nome = "buscarHashVetor";
+                        buscarHashVetor(&indice, consultas[i]);
+                        c = comparacoesHash;
+                        break;
+                    case 5:
+                        nome = "buscarSequencialLista";
+                        buscarSequencialLista(lista.inicio, consultas[i]);
+                        c = comparacoesSequencialLista;
+                        break;
+                    case 6:
+                        nome = "buscarSequencialDesenrolada";
+                        buscarSequencialDesenrolada(&desenrolada, consultas[i]);
+                        c = comparacoesSequencialDesenrolada;
+                        break;
+                    default:
+                        nome = "buscarHashLista";
+                        buscarHashLista(&lista, consultas[i]);
+                        c = comparacoesHashLista;
+                        break;
+                }
+                total += c;
+            }
+            long long dt = cronometro_agoraNs() - t0;
+            if (r >= 0) amostras[r] = dt / q; // ns por consulta
+            comps = (double)total / q;
+        }
+        escreverLinha(cfg, nome, dist, n, amostras, cfg->repeticoes, comps);
+    }
+
+    indice_liberar(&indice);
+    liberarMochilaLista(&lista);
+    liberarMochilaDesenrolada(&desenrolada);
+    liberarColunas(&colunas);
+    free(ordenado);
+    free(itens);
+    free(itensOrdenados);
+    free(consultas);
+}
+
+// -----------------------------
+// Armazém de mochilas: T threads, cada uma com a sua sequência de operações
+// sobre jogadores sorteados (busca, cadastro + remoção, tamanho, ordenação).
+// O trabalho por thread é fixo: com escala linear o tempo de parede não
+// muda e o tempo por operação cai com T. Na coluna 'operacoes' vai o
+// total de operações da medição.
+// -----------------------------
+#define ITENS_POR_JOGADOR 16
+#define OPERACOES_POR_THREAD 200000
+
+typedef struct {
+    Armazem *armazem;
+    int jogadores;
+    uint64_t estado; // xorshift64* próprio: a thread não disputa o gerador global
+    long acertos;
+} TarefaArmazem;
+
+uint64_t aleatorioLocal(uint64_t *estado) {
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return *estado * 2685821657736338717ULL;
+}
+
+void nomeItemSintetico(Item *item, int k) {
+    memset(item, 0, sizeof(Item));
+    snprintf(item->nome, TAM_NOME_ITEM, "I%05d", k);
+    strncpy(item->tipo, tiposSinteticos[k % NUM_TIPOS_SINTETICOS], TAM_TIPO_ITEM - 1);
+    item->quantidade = k;
+}
+
+void rodarTarefaArmazem(void *arg) {
+    TarefaArmazem *t = (TarefaArmazem *)arg;
+    Item item;
+    for (int i = 0; i < OPERACOES_POR_THREAD; i++) {
+        uint64_t r = aleatorioLocal(&t->estado);
+        int jogador = (int)(r % (uint64_t)t->jogadores);
+        int tipo = (int)((r >> 32) & 7);
+        int k = (int)((r >> 40) % (2 * ITENS_POR_JOGADOR)); // metade dos nomes não existe
+        if (tipo < 4) {
+            char nome[TAM_NOME_ITEM];
+            snprintf(nome, sizeof(nome), "I%05d", k);
+            t->acertos += armazem_buscar(t->armazem, jogador, nome, &item);
+        } else if (tipo < 6) {
+            nomeItemSintetico(&item, ITENS_POR_JOGADOR * 2 + k);
+            armazem_inserir(t->armazem, jogador, &item);
+            t->acertos += armazem_remover(t->armazem, jogador, item.nome, NULL);
+        } else if (tipo == 6) {
+            t->acertos += armazem_tamanho(t->armazem, jogador) > 0;
+        } else {
+            armazem_ordenar(t->armazem, jogador, compararNomeItem);
+        }
+    }
+}
+
+void medirArmazem(Config *cfg, long long *amostras) {
+    int maxThreads = threadsEmUso();
+    Armazem *armazem = ordenacao_alocar(sizeof(Armazem));
+    TarefaArmazem *tarefas = ordenacao_alocar((size_t)maxThreads * sizeof(TarefaArmazem));
+    armazem_iniciar(armazem, sizeof(Item), offsetof(Item, nome));
+    Item item;
+    for (int j = 0; j < cfg->jogadores; j++) {
+        for (int k = 0; k < ITENS_POR_JOGADOR; k++) {
+            nomeItemSintetico(&item, k);
+            armazem_inserir(armazem, j, &item);
+        }
+    }
+
+    // 1, 2, 4, ... e por último maxThreads
+    for (int threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+        for (int r = -cfg->aquecimento; r < cfg->repeticoes; r++) {
+            for (int t = 0; t < threads; t++) {
+                tarefas[t].armazem = armazem;
+                tarefas[t].jogadores = cfg->jogadores;
+                tarefas[t].estado = cfg->semente * 0x9E3779B97F4A7C15ULL + (uint64_t)t * 7919 + 1;
+                tarefas[t].acertos = 0;
+            }
+            long long t0 = cronometro_agoraNs();
+            paralelo_simultaneas(rodarTarefaArmazem, tarefas, sizeof(TarefaArmazem), threads);
+            long long dt = cronometro_agoraNs() - t0;
+            if (r >= 0) amostras[r] = dt / ((long long)threads * OPERACOES_POR_THREAD); // ns por operação
+        }
+        char nome[64];
+        snprintf(nome, sizeof(nome), "armazem (%d thread%s)", threads, threads > 1 ? "s" : "");
+        escreverLinhaMedidas(cfg, nome, DIST_ALEATORIA, cfg->jogadores, amostras, cfg->repeticoes, -1,
+                             (double)threads * OPERACOES_POR_THREAD, -1);
+        if (threads == maxThreads) break;
+    }
+
+    armazem_liberar(armazem);
+    free(armazem);
+    free(tarefas);
+}
+
+// -----------------------------
+// Estresse de leitura: R threads fazem buscas binárias por nome num vetor
+// versionado enquanto uma thread insere e remove a uma taxa alvo. As
+// leituras "versionadas" não tomam trava nenhuma; as "com trava" são as
+// mesmas buscas dentro da trava dos escritores, como num vetor comum
+// protegido por mutex. O tempo é o de parede dividido pelo total de
+// leituras (ns por leitura, somando as threads); na coluna 'escritas_por_s'
+// vão as escritas por segundo de fato feitas.
+// -----------------------------
+#define ESTRESSE_MS 200
+
+const int taxasEscrita[] = { 0, 1000, 10000, 100000, -1 }; // -1: sem pausa entre escritas
+#define NUM_TAXAS_ESCRITA 5
+
+typedef struct {
+    RegistrosVersionados *registros;
+    const char (*nomes)[STRLEN];
+    int numNomes;
+    atomic_int *parar;
+    int escritor;   // 1: a thread que escreve (e marca o fim da medição)
+    int taxa;       // escritas por segundo do escritor
+    int comTrava;   // leituras dentro da trava de escrita
+    uint64_t estado;
+    long operacoes; // leituras ou escritas feitas
+    long acertos;
+} TarefaEstresse;
+
+void dormirAte(long long instanteNs) {
+    long long falta = instanteNs - cronometro_agoraNs();
+    if (falta <= 0) return;
+    struct timespec t = { (time_t)(falta / 1000000000LL), (long)(falta % 1000000000LL) };
+    nanosleep(&t, NULL);
+}
+
+void escreverEstresse(TarefaEstresse *t) {
+    long long inicio = cronometro_agoraNs(), fim = inicio + ESTRESSE_MS * 1000000LL;
+    Componente c;
+    while (cronometro_agoraNs() < fim) {
+        if (t->taxa == 0) {
+            dormirAte(fim);
+            break;
+        }
+        if (t->taxa > 0) dormirAte(inicio + t->operacoes * 1000000000LL / t->taxa);
+        // insere e depois remove o mesmo nome: o tamanho fica estável
+        memset(&c, 0, sizeof(c));
+        snprintf(c.nome, STRLEN, "W%09ld", t->operacoes / 2);
+        if (t->operacoes % 2 == 0) versoes_inserir(t->registros, &c);
+        else versoes_remover(t->registros, &c, NULL);
+        t->operacoes++;
+    }
+    atomic_store(t->parar, 1);
+}
+
+void lerEstresse(TarefaEstresse *t) {
+    RegistrosVersionados *r = t->registros;
+    int leitor = t->comTrava ? -1 : versoes_registrarLeitor(r);
+    Componente sonda;
+    long comps;
+    while (!atomic_load_explicit(t->parar, memory_order_relaxed)) {
+        memcpy(sonda.nome, t->nomes[aleatorioLocal(&t->estado) % (uint64_t)t->numNomes], STRLEN);
+        if (leitor >= 0) {
+            t->acertos += versoes_buscarCopia(r, leitor, &sonda, NULL, &comps);
+        } else {
+            versoes_travarEscrita(r);
+            t->acertos += versoes_buscar(atomic_load(&r->atual), r->cmp, &sonda, &comps) >= 0;
+            versoes_destravarEscrita(r);
+        }
+        t->operacoes++;
+    }
+}
+
+void rodarTarefaEstresse(void *arg) {
+    TarefaEstresse *t = (TarefaEstresse *)arg;
+    if (t->escritor) escreverEstresse(t);
+    else lerEstresse(t);
+}
+
+void medirLeituraVersionada(Config *cfg, const Componente *base, int n, Distribuicao dist, long long *amostras) {
+    int leitores = cfg->leitores;
+    Componente *ordenado = ordenacao_alocar((size_t)n * sizeof(Componente));
+    char (*nomes)[STRLEN] = ordenacao_alocar((size_t)n * STRLEN);
+    TarefaEstresse *tarefas = ordenacao_alocar((size_t)(leitores + 1) * sizeof(TarefaEstresse));
+    long dummy;
+    memcpy(ordenado, base, (size_t)n * sizeof(Componente));
+    mergeSortNome(ordenado, n, &dummy);
+    for (int i = 0; i < n; i++) memcpy(nomes[i], base[i].nome, STRLEN);
+
+    for (int comTrava = 0; comTrava <= 1; comTrava++) {
+        for (int k = 0; k < NUM_TAXAS_ESCRITA; k++) {
+            double escritasPorSegundo = 0;
+            for (int r = -cfg->aquecimento; r < cfg->repeticoes; r++) {
+                RegistrosVersionados registros;
+                atomic_int parar;
+                atomic_init(&parar, 0);
+                versoes_iniciar(&registros, sizeof(Componente), compararNome, ordenado, n);
+                for (int t = 0; t <= leitores; t++) {
+                    tarefas[t] = (TarefaEstresse){ &registros, (const char (*)[STRLEN])nomes, n, &parar,
+                                                   t == leitores, taxasEscrita[k], comTrava,
+                                                   cfg->semente * 0x9E3779B97F4A7C15ULL + (uint64_t)t * 7919 + 1,
+                                                   0, 0 };
+                }
+                long long t0 = cronometro_agoraNs();
+                paralelo_simultaneas(rodarTarefaEstresse, tarefas, sizeof(TarefaEstresse), leitores + 1);
+                long long dt = cronometro_agoraNs() - t0;
+                long leituras = 0;
+                for (int t = 0; t < leitores; t++) leituras += tarefas[t].operacoes;
+                if (r >= 0) amostras[r] = leituras > 0 ? dt / leituras : dt;
+                escritasPorSegundo = (double)tarefas[leitores].operacoes * 1e9 / (double)dt;
+                versoes_liberar(&registros);
+            }
+            char nome[96], taxa[32];
+            if (taxasEscrita[k] < 0) snprintf(taxa, sizeof(taxa), "sem limite");
+            else snprintf(taxa, sizeof(taxa), "%d/s", taxasEscrita[k]);
+            snprintf(nome, sizeof(nome), "leitura %s (%d leitores; escritas %s)",
+                     comTrava ? "com trava" : "versionada", leitores, taxa);
+            escreverLinhaMedidas(cfg, nome, dist, n, amostras, cfg->repeticoes, -1, -1, escritasPorSegundo);
+        }
+    }
+    free(ordenado);
+    free(nomes);
+    free(tarefas);
+}
+
+// -----------------------------
+// Linha de comando
+// -----------------------------
+int lerTamanhos(Config *cfg, const char *lista) {
+    cfg->numTamanhos = 0;
+    const char *p = lista;
+    while (*p && cfg->numTamanhos < MAX_TAMANHOS) {
+        char *fim;
+        double v = strtod(p, &fim); // aceita 1e5
+        if (fim == p || v < 1 || v > 1e8) return 0;
+        cfg->tamanhos[cfg->numTamanhos++] = (int)v;
+        p = (*fim == ',') ? fim + 1 : fim;
+        if (*fim && *fim != ',') return 0;
+    }
+    return cfg->numTamanhos > 0;
+}
+
+int lerDistribuicoes(Config *cfg, const char *lista) {
+    for (int d = 0; d < NUM_DISTRIBUICOES; d++) cfg->distribuicoes[d] = strstr(lista, nomesDistribuicao[d]) != NULL;
+    for (int d = 0; d < NUM_DISTRIBUICOES; d++) if (cfg->distribuicoes[d]) return 1;
+    return 0;
+}
+
+void uso(void) {
+    fprintf(stderr,
+            "Uso: ./benchmark [--tamanhos 100,1000,...] [--distribuicoes aleatoria,ordenada,inversa,duplicadas]\n"
+            "                 [--repeticoes R] [--aquecimento W] [--max-quadratico N]\n"
+            "                 [--consultas Q] [--semente S] [--threads T] [--jogadores J]\n"
+            "                 [--leitores R] [--saida arquivo.csv]\n");
+}
+
+int main(int argc, char *argv[]) {
+    Config cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cronometro_ativo = 0;
+    lerTamanhos(&cfg, "100,1000,10000,100000");
+    for (int d = 0; d < NUM_DISTRIBUICOES; d++) cfg.distribuicoes[d] = 1;
+    cfg.repeticoes = 5;
+    cfg.aquecimento = 1;
+    cfg.maxQuadratico = 20000;
+    cfg.consultas = 1000;
+    cfg.semente = 42;
+    cfg.saida = stdout;
+
+    for (int i = 1; i < argc; i++) {
+        const char *opt = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        int ok = val != NULL;
+        if (ok && strcmp(opt, "--tamanhos") == 0) ok = lerTamanhos(&cfg, val);
+        else if (ok && strcmp(opt, "--distribuicoes") == 0) ok = lerDistribuicoes(&cfg, val);
+        else if (ok && strcmp(opt, "--repeticoes") == 0) ok = (cfg.repeticoes = atoi(val)) > 0;
+        else if (ok && strcmp(opt, "--aquecimento") == 0) ok = (cfg.aquecimento = atoi(val)) >= 0;
+        else if (ok && strcmp(opt, "--max-quadratico") == 0) ok = (cfg.maxQuadratico = atoi(val)) >= 0;
+        else if (ok && strcmp(opt, "--consultas") == 0) ok = (cfg.consultas = atoi(val)) > 0;
+        else if (ok && strcmp(opt, "--jogadores") == 0) ok = (cfg.jogadores = atoi(val)) >= 0;
+        else if (ok && strcmp(opt, "--leitores") == 0)
+            ok = (cfg.leitores = atoi(val)) >= 0 && cfg.leitores < VERSOES_MAX_LEITORES;
+        else if (ok && strcmp(opt, "--semente") == 0) cfg.semente = strtoull(val, NULL, 10);
+        else if (ok && strcmp(opt, "--threads") == 0)
+            ok = (threadsOrdenacao = atoi(val)) > 0 && threadsOrdenacao <= PARALELO_MAX_THREADS;
+        else if (ok && strcmp(opt, "--saida") == 0) ok = (cfg.saida = fopen(val, "w")) != NULL;
+        else ok = 0;
+        if (!ok) { uso(); return 1; }
+        i++;
+    }
+
+    long long *amostras = malloc((size_t)cfg.repeticoes * sizeof(long long));
+    if (amostras == NULL) return 1;
+
+    fprintf(cfg.saida, CABECALHO_CSV "\n");
+    for (int t = 0; t < cfg.numTamanhos; t++) {
+        int n = cfg.tamanhos[t];
+        Componente *base = malloc((size_t)n * sizeof(Componente));
+        if (base == NULL) { fprintf(stderr, "Memória insuficiente (n=%d).\n", n); continue; }
+        for (int d = 0; d < NUM_DISTRIBUICOES; d++) {
+            if (!cfg.distribuicoes[d]) continue;
+            // cada caso usa a mesma semente: resultados não dependem da ordem
+            estadoAleatorio = cfg.semente * 0x9E3779B97F4A7C15ULL + (uint64_t)n * 31 + (uint64_t)d + 1;
+            gerarComponentes(base, n, (Distribuicao)d);
+            medirOrdenacoes(&cfg, base, n, (Distribuicao)d, amostras);
+            medirBuscas(&cfg, base, n, (Distribuicao)d, amostras);
+            if (cfg.leitores > 0) medirLeituraVersionada(&cfg, base, n, (Distribuicao)d, amostras);
+        }
+        free(base);
+    }
+    if (cfg.jogadores > 0) medirArmazem(&cfg, amostras);
+
+    free(amostras);
+    paralelo_encerrar(&paralelo_pool);
+    if (cfg.saida != stdout) fclose(cfg.saida);
+    return 0;
+}
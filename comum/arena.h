@@ -0,0 +1,118 @@
+/* arena.h
+ *
+ * Alocador por região (bump allocator) compartilhado pelos três níveis.
+ * Reserva blocos grandes com malloc e entrega fatias sequenciais deles.
+ * Nada é liberado individualmente: arena_liberar() devolve tudo de uma vez.
+ */
+
+#ifndef FREEFIRE_ARENA_H
+#define FREEFIRE_ARENA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_BLOCO_MIN ((size_t)1 << 20) // 1 MiB
+#define ARENA_ALINHAMENTO 16
+
+// -----------------------------
+// Estruturas
+// -----------------------------
+
+// Bloco de memória da arena; os dados vêm logo após o cabeçalho
+typedef struct BlocoArena {
+    struct BlocoArena *anterior;
+    size_t capacidade; // bytes úteis após o cabeçalho
+    size_t usado;
+} BlocoArena;
+
+typedef struct {
+    BlocoArena *atual;
+    void *ultima;        // última alocação (pode crescer no lugar)
+    size_t totalReservado;
+} Arena;
+
+#define ARENA_CABECALHO \
+    ((sizeof(BlocoArena) + ARENA_ALINHAMENTO - 1) & ~(size_t)(ARENA_ALINHAMENTO - 1))
+
+static inline size_t arena_alinhar(size_t tam) {
+    return (tam + ARENA_ALINHAMENTO - 1) & ~(size_t)(ARENA_ALINHAMENTO - 1);
+}
+
+static inline char *arena_dados(BlocoArena *b) {
+    return (char *)b + ARENA_CABECALHO;
+}
+
+// -----------------------------
+// Operações
+// -----------------------------
+
+static inline void arena_iniciar(Arena *a) {
+    a->atual = NULL;
+    a->ultima = NULL;
+    a->totalReservado = 0;
+}
+
+// Reserva um novo bloco com pelo menos 'minimo' bytes úteis
+static inline void arena_novoBloco(Arena *a, size_t minimo) {
+    size_t cap = ARENA_BLOCO_MIN;
+    // blocos crescem junto com a arena para manter poucas chamadas a malloc
+    if (a->totalReservado > cap) cap = a->totalReservado;
+    if (minimo > cap) cap = minimo;
+
+    BlocoArena *b = (BlocoArena *)malloc(ARENA_CABECALHO + cap);
+    if (b == NULL) {
+        fprintf(stderr, "Memória insuficiente (arena).\n");
+        exit(1);
+    }
+    b->anterior = a->atual;
+    b->capacidade = cap;
+    b->usado = 0;
+    a->atual = b;
+    a->totalReservado += cap;
+}
+
+// Aloca 'tam' bytes alinhados a 16; memória não é zerada
+static inline void *arena_alocar(Arena *a, size_t tam) {
+    tam = arena_alinhar(tam == 0 ? 1 : tam);
+    if (a->atual == NULL || a->atual->capacidade - a->atual->usado < tam) {
+        arena_novoBloco(a, tam);
+    }
+    void *p = arena_dados(a->atual) + a->atual->usado;
+    a->atual->usado += tam;
+    a->ultima = p;
+    return p;
+}
+
+// Redimensiona uma alocação. Se 'ptr' for a última alocação do bloco atual
+// e couber, cresce no lugar; caso contrário aloca de novo e copia.
+// O espaço antigo só volta ao sistema em arena_liberar().
+static inline void *arena_realocar(Arena *a, void *ptr, size_t tamAntigo, size_t tamNovo) {
+    if (ptr == NULL) return arena_alocar(a, tamNovo);
+
+    if (ptr == a->ultima) {
+        size_t inicio = (size_t)((char *)ptr - arena_dados(a->atual));
+        size_t necessario = arena_alinhar(tamNovo);
+        if (inicio + necessario <= a->atual->capacidade) {
+            a->atual->usado = inicio + necessario;
+            return ptr;
+        }
+    }
+
+    void *novo = arena_alocar(a, tamNovo);
+    memcpy(novo, ptr, tamAntigo < tamNovo ? tamAntigo : tamNovo);
+    return novo;
+}
+
+// Libera todos os blocos de uma vez
+static inline void arena_liberar(Arena *a) {
+    BlocoArena *b = a->atual;
+    while (b != NULL) {
+        BlocoArena *ant = b->anterior;
+        free(b);
+        b = ant;
+    }
+    arena_iniciar(a);
+}
+
+#endif
@@ -0,0 +1,268 @@
+/* armazem.h
+ *
+ * Muitas mochilas independentes num só processo, uma por jogador (id
+ * inteiro), para servir milhares de jogadores ao mesmo tempo. Cada mochila
+ * é um Inventario de registros de tamanho fixo com um IndiceNome
+ * (../comum/indice.h), como a mochila do nível Aventureiro.
+ *
+ * Os jogadores são repartidos em ARMAZEM_SHARDS partes pelo hash do id.
+ * Cada parte tem a sua trava, a sua arena e a sua tabela jogador -> mochila,
+ * então operações de jogadores em partes diferentes não disputam nada e
+ * escalam com o número de núcleos. As partes ficam em linhas de cache
+ * separadas, para a trava de uma não invalidar a vizinha.
+ *
+ * Todas as funções armazem_* podem ser chamadas de várias threads. Elas
+ * seguram a trava da parte só durante a operação e copiam os registros
+ * para fora: nenhum ponteiro para dentro de uma mochila escapa da trava.
+ * armazem_ordenar() segura a trava durante a ordenação, o que atrasa só os
+ * jogadores da mesma parte.
+ *
+ * Sem pthreads (fora de Unix) não há travas e o armazém é de uma thread só.
+ */
+
+#ifndef FREEFIRE_ARMAZEM_H
+#define FREEFIRE_ARMAZEM_H
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "indice.h"
+#include "inventario.h"
+#include "ordenacao.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define ARMAZEM_TEM_THREADS 1
+#else
+#define ARMAZEM_TEM_THREADS 0
+#endif
+
+#define ARMAZEM_BITS_SHARD 6
+#define ARMAZEM_SHARDS (1 << ARMAZEM_BITS_SHARD)
+#define ARMAZEM_CAP_TABELA 16 // mochilas por parte antes do primeiro crescimento
+#define ARMAZEM_LINHA_CACHE 64
+
+// Visitante de armazem_visitar(): devolve 0 para parar
+typedef int (*VisitaArmazem)(const void *registro, void *contexto);
+
+typedef struct {
+    int jogador;
+    Inventario itens;
+    IndiceNome indice; // nome -> posição em 'itens'
+} MochilaArmazem;
+
+typedef struct {
+#if ARMAZEM_TEM_THREADS
+    pthread_mutex_t trava;
+#endif
+    Arena arena;             // mochilas e itens desta parte
+    MochilaArmazem **tabela; // sondagem linear; NULL = espaço vazio
+    int capTabela;           // potência de 2
+    int numMochilas;
+    char separador[ARMAZEM_LINHA_CACHE]; // a próxima parte começa em outra linha
+} ShardArmazem;
+
+typedef struct {
+    ShardArmazem shards[ARMAZEM_SHARDS];
+    size_t tamElem;
+    size_t offsetNome;
+} Armazem;
+
+// Espalha ids consecutivos por todas as partes (finalizador do MurmurHash3)
+static inline uint32_t armazem_hash(int jogador) {
+    uint32_t h = (uint32_t)jogador;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+static inline void armazem_iniciar(Armazem *a, size_t tamElem, size_t offsetNome) {
+    a->tamElem = tamElem;
+    a->offsetNome = offsetNome;
+    for (int s = 0; s < ARMAZEM_SHARDS; s++) {
+        ShardArmazem *sh = &a->shards[s];
+#if ARMAZEM_TEM_THREADS
+        pthread_mutex_init(&sh->trava, NULL);
+#endif
+        arena_iniciar(&sh->arena);
+        sh->tabela = NULL;
+        sh->capTabela = 0;
+        sh->numMochilas = 0;
+    }
+}
+
+// Só quando nenhuma outra thread usa mais o armazém
+static inline void armazem_liberar(Armazem *a) {
+    for (int s = 0; s < ARMAZEM_SHARDS; s++) {
+        ShardArmazem *sh = &a->shards[s];
+        for (int i = 0; i < sh->capTabela; i++)
+            if (sh->tabela[i] != NULL) indice_liberar(&sh->tabela[i]->indice);
+        free(sh->tabela);
+        arena_liberar(&sh->arena);
+#if ARMAZEM_TEM_THREADS
+        pthread_mutex_destroy(&sh->trava);
+#endif
+    }
+}
+
+// Trava a parte do jogador e devolve ela
+static inline ShardArmazem *armazem_travar(Armazem *a, int jogador) {
+    ShardArmazem *sh = &a->shards[armazem_hash(jogador) & (ARMAZEM_SHARDS - 1)];
+#if ARMAZEM_TEM_THREADS
+    pthread_mutex_lock(&sh->trava);
+#endif
+    return sh;
+}
+
+static inline void armazem_destravar(ShardArmazem *sh) {
+#if ARMAZEM_TEM_THREADS
+    pthread_mutex_unlock(&sh->trava);
+#else
+    (void)sh;
+#endif
+}
+
+// Espaço da tabela com a mochila do jogador, ou o vazio onde ela entraria
+static inline int armazem_espaco(const ShardArmazem *sh, int jogador) {
+    int mascara = sh->capTabela - 1;
+    int i = (int)((armazem_hash(jogador) >> ARMAZEM_BITS_SHARD) & (uint32_t)mascara); // bits que a parte não usou
+    while (sh->tabela[i] != NULL && sh->tabela[i]->jogador != jogador) i = (i + 1) & mascara;
+    return i;
+}
+
+static inline void armazem_crescerTabela(ShardArmazem *sh) {
+    MochilaArmazem **antiga = sh->tabela;
+    int capAntiga = sh->capTabela;
+    size_t novaCap = capAntiga > 0 ? (size_t)capAntiga * 2 : ARMAZEM_CAP_TABELA;
+    sh->tabela = novaCap <= (size_t)INT_MAX ? (MochilaArmazem **)calloc(novaCap, sizeof(MochilaArmazem *)) : NULL;
+    sh->capTabela = (int)novaCap;
+    if (sh->tabela == NULL) {
+        fprintf(stderr, "Memória insuficiente (armazém).\n");
+        exit(1);
+    }
+    for (int i = 0; i < capAntiga; i++)
+        if (antiga[i] != NULL) sh->tabela[armazem_espaco(sh, antiga[i]->jogador)] = antiga[i];
+    free(antiga);
+}
+
+// Mochila do jogador (trava da parte já obtida); criada vazia se 'criar'
+static inline MochilaArmazem *armazem_mochila(Armazem *a, ShardArmazem *sh, int jogador, int criar) {
+    if (sh->capTabela > 0) {
+        MochilaArmazem *m = sh->tabela[armazem_espaco(sh, jogador)];
+        if (m != NULL || !criar) return m;
+    } else if (!criar) {
+        return NULL;
+    }
+    if ((sh->numMochilas + 1) * 2 > sh->capTabela) armazem_crescerTabela(sh);
+    // na arena o endereço não muda: o índice aponta para m->itens
+    MochilaArmazem *m = (MochilaArmazem *)arena_alocar(&sh->arena, sizeof(MochilaArmazem));
+    m->jogador = jogador;
+    inventario_iniciar(&m->itens, &sh->arena, a->tamElem);
+    indice_iniciar(&m->indice, &m->itens, a->offsetNome);
+    sh->tabela[armazem_espaco(sh, jogador)] = m;
+    sh->numMochilas++;
+    return m;
+}
+
+// -----------------------------
+// Operações por jogador (seguras entre threads)
+// -----------------------------
+
+// Anexa uma cópia do registro à mochila do jogador; devolve o novo tamanho
+static inline int armazem_inserir(Armazem *a, int jogador, const void *registro) {
+    ShardArmazem *sh = armazem_travar(a, jogador);
+    MochilaArmazem *m = armazem_mochila(a, sh, jogador, 1);
+    memcpy(inventario_anexar(&m->itens), registro, a->tamElem);
+    indice_inserir(&m->indice, m->itens.tamanho - 1);
+    int tamanho = m->itens.tamanho;
+    armazem_destravar(sh);
+    return tamanho;
+}
+
+// Copia para 'saida' (se não for NULL) o registro com esse nome; 0 se não há
+static inline int armazem_buscar(Armazem *a, int jogador, const char *nome, void *saida) {
+    ShardArmazem *sh = armazem_travar(a, jogador);
+    MochilaArmazem *m = armazem_mochila(a, sh, jogador, 0);
+    int pos = m != NULL ? indice_buscar(&m->indice, nome, NULL) : -1;
+    if (pos >= 0 && saida != NULL) memcpy(saida, inventario_em(&m->itens, pos), a->tamElem);
+    armazem_destravar(sh);
+    return pos >= 0;
+}
+
+// Remove o registro com esse nome em O(1) (o último ocupa o lugar dele);
+// copia-o para 'saida' se não for NULL. Devolve 0 se não há.
+static inline int armazem_remover(Armazem *a, int jogador, const char *nome, void *saida) {
+    ShardArmazem *sh = armazem_travar(a, jogador);
+    MochilaArmazem *m = armazem_mochila(a, sh, jogador, 0);
+    int pos = m != NULL ? indice_buscar(&m->indice, nome, NULL) : -1;
+    if (pos >= 0) {
+        if (saida != NULL) memcpy(saida, inventario_em(&m->itens, pos), a->tamElem);
+        indice_removerTrocandoUltimo(&m->indice, &m->itens, pos);
+    }
+    armazem_destravar(sh);
+    return pos >= 0;
+}
+
+// Ordena a mochila do jogador (Merge Sort estável por índices, ../comum/ordenacao.h)
+// e refaz o índice. Devolve o número de comparações.
+static inline long armazem_ordenar(Armazem *a, int jogador, Comparador cmp) {
+    long comparacoes = 0;
+    ShardArmazem *sh = armazem_travar(a, jogador);
+    MochilaArmazem *m = armazem_mochila(a, sh, jogador, 0);
+    if (m != NULL && m->itens.tamanho > 1) {
+        int n = m->itens.tamanho;
+        int *perm = (int *)ordenacao_alocar((size_t)n * sizeof(int));
+        ordenacao_identidade(perm, n);
+        comparacoes = ordenacao_mergesort(m->itens.dados, a->tamElem, perm, n, cmp);
+        ordenacao_aplicarPermutacao(m->itens.dados, a->tamElem, perm, n);
+        indice_reconstruir(&m->indice);
+        free(perm);
+    }
+    armazem_destravar(sh);
+    return comparacoes;
+}
+
+static inline int armazem_tamanho(Armazem *a, int jogador) {
+    ShardArmazem *sh = armazem_travar(a, jogador);
+    MochilaArmazem *m = armazem_mochila(a, sh, jogador, 0);
+    int tamanho = m != NULL ? m->itens.tamanho : 0;
+    armazem_destravar(sh);
+    return tamanho;
+}
+
+// Visita os registros do jogador na ordem da mochila, com a trava da parte
+// obtida: o visitante não deve chamar o armazém. Devolve quantos visitou.
+static inline int armazem_visitar(Armazem *a, int jogador, VisitaArmazem visita, void *contexto) {
+    ShardArmazem *sh = armazem_travar(a, jogador);
+    MochilaArmazem *m = armazem_mochila(a, sh, jogador, 0);
+    int i = 0;
+    while (m != NULL && i < m->itens.tamanho) {
+        if (!visita(inventario_em(&m->itens, i++), contexto)) break;
+    }
+    armazem_destravar(sh);
+    return i;
+}
+
+// Jogadores com mochila (trava uma parte por vez: é uma fotografia aproximada
+// se houver cadastros acontecendo)
+static inline int armazem_numJogadores(Armazem *a) {
+    int total = 0;
+    for (int s = 0; s < ARMAZEM_SHARDS; s++) {
+        ShardArmazem *sh = &a->shards[s];
+#if ARMAZEM_TEM_THREADS
+        pthread_mutex_lock(&sh->trava);
+#endif
+        total += sh->numMochilas;
+        armazem_destravar(sh);
+    }
+    return total;
+}
+
+#endif
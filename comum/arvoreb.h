@@ -0,0 +1,292 @@
+/* arvoreb.h
+ *
+ * Árvore B de registros de tamanho fixo, guardados dentro dos próprios nós
+ * (até 2t-1 por nó, lado a lado), ordenados por um Comparador. Inserção e
+ * remoção são O(log n) e o percurso em ordem permite consultas por faixa.
+ *
+ * O comparador deve ser uma ordem total sobre os registros (desempatar por
+ * todos os campos): a remoção procura o registro igual a 'chave'. Para
+ * buscar por parte da chave, monte uma sonda com os demais campos no valor
+ * mínimo e use arvoreb_limiteInferior().
+ *
+ * Os nós vêm de um PoolNos; arvoreb_liberar() descarta a árvore inteira.
+ */
+
+#ifndef FREEFIRE_ARVOREB_H
+#define FREEFIRE_ARVOREB_H
+
+#include "pool.h"
+
+#define ARVOREB_GRAU 8                       // grau mínimo t
+#define ARVOREB_MAX_REG (2 * ARVOREB_GRAU - 1)
+
+// Compara dois registros: <0, 0 ou >0 (mesmo contrato de ordenacao.h)
+typedef int (*ComparadorArvore)(const void *a, const void *b);
+
+// Recebe cada registro da faixa; devolver 0 interrompe o percurso
+typedef int (*VisitaRegistro)(const void *registro, void *contexto);
+
+// Nó: cabeçalho, filhos e, logo depois, os registros
+typedef struct NoArvoreB {
+    int quantidade;
+    int folha;
+    struct NoArvoreB *filhos[2 * ARVOREB_GRAU];
+} NoArvoreB;
+
+typedef struct {
+    PoolNos pool;
+    NoArvoreB *raiz;
+    size_t tamElem;
+    ComparadorArvore cmp;
+    int tamanho;
+    long comparacoes; // acumulado; quem mede zera antes
+} ArvoreB;
+
+static inline void arvoreb_iniciar(ArvoreB *t, size_t tamElem, ComparadorArvore cmp) {
+    pool_iniciar(&t->pool, sizeof(NoArvoreB) + ARVOREB_MAX_REG * tamElem);
+    t->raiz = NULL;
+    t->tamElem = tamElem;
+    t->cmp = cmp;
+    t->tamanho = 0;
+    t->comparacoes = 0;
+}
+
+static inline void arvoreb_liberar(ArvoreB *t) {
+    pool_liberar(&t->pool);
+    t->raiz = NULL;
+    t->tamanho = 0;
+}
+
+static inline char *arvoreb_reg(const ArvoreB *t, NoArvoreB *x, int i) {
+    return (char *)(x + 1) + (size_t)i * t->tamElem;
+}
+
+static inline int arvoreb_cmp(ArvoreB *t, const void *a, const void *b) {
+    t->comparacoes++;
+    return t->cmp(a, b);
+}
+
+static inline NoArvoreB *arvoreb_novoNo(ArvoreB *t, int folha) {
+    NoArvoreB *x = (NoArvoreB *)pool_alocar(&t->pool);
+    x->quantidade = 0;
+    x->folha = folha;
+    return x;
+}
+
+// Primeiro i com reg[i] >= chave (estrito: reg[i] > chave), por busca binária
+static inline int arvoreb_posicao(ArvoreB *t, NoArvoreB *x, const void *chave, int estrito) {
+    int ini = 0, fim = x->quantidade;
+    while (ini < fim) {
+        int meio = (ini + fim) / 2;
+        int c = arvoreb_cmp(t, arvoreb_reg(t, x, meio), chave);
+        if (c < 0 || (estrito && c == 0)) ini = meio + 1;
+        else fim = meio;
+    }
+    return ini;
+}
+
+// -----------------------------
+// Inserção (divide nós cheios na descida)
+// -----------------------------
+
+// Divide o filho cheio x->filhos[i]; o registro do meio sobe para x
+static inline void arvoreb_dividir(ArvoreB *t, NoArvoreB *x, int i) {
+    const int T = ARVOREB_GRAU;
+    size_t e = t->tamElem;
+    NoArvoreB *y = x->filhos[i];
+    NoArvoreB *z = arvoreb_novoNo(t, y->folha);
+
+    z->quantidade = T - 1;
+    memcpy(arvoreb_reg(t, z, 0), arvoreb_reg(t, y, T), (size_t)(T - 1) * e);
+    if (!y->folha) memcpy(z->filhos, y->filhos + T, (size_t)T * sizeof(NoArvoreB *));
+    y->quantidade = T - 1;
+
+    memmove(x->filhos + i + 2, x->filhos + i + 1, (size_t)(x->quantidade - i) * sizeof(NoArvoreB *));
+    x->filhos[i + 1] = z;
+    memmove(arvoreb_reg(t, x, i + 1), arvoreb_reg(t, x, i), (size_t)(x->quantidade - i) * e);
+    memcpy(arvoreb_reg(t, x, i), arvoreb_reg(t, y, T - 1), e);
+    x->quantidade++;
+}
+
+static inline void arvoreb_inserir(ArvoreB *t, const void *registro) {
+    if (t->raiz == NULL) t->raiz = arvoreb_novoNo(t, 1);
+    if (t->raiz->quantidade == ARVOREB_MAX_REG) {
+        NoArvoreB *s = arvoreb_novoNo(t, 0);
+        s->filhos[0] = t->raiz;
+        t->raiz = s;
+        arvoreb_dividir(t, s, 0);
+    }
+
+    NoArvoreB *x = t->raiz;
+    while (1) {
+        int i = arvoreb_posicao(t, x, registro, 1);
+        if (x->folha) {
+            memmove(arvoreb_reg(t, x, i + 1), arvoreb_reg(t, x, i),
+                    (size_t)(x->quantidade - i) * t->tamElem);
+            memcpy(arvoreb_reg(t, x, i), registro, t->tamElem);
+            x->quantidade++;
+            break;
+        }
+        if (x->filhos[i]->quantidade == ARVOREB_MAX_REG) {
+            arvoreb_dividir(t, x, i);
+            if (arvoreb_cmp(t, arvoreb_reg(t, x, i), registro) <= 0) i++;
+        }
+        x = x->filhos[i];
+    }
+    t->tamanho++;
+}
+
+// -----------------------------
+// Remoção (garante t registros no filho antes de descer)
+// -----------------------------
+
+// Junta x->filhos[i], o registro i de x e x->filhos[i+1] num só nó
+static inline void arvoreb_fundir(ArvoreB *t, NoArvoreB *x, int i) {
+    size_t e = t->tamElem;
+    NoArvoreB *y = x->filhos[i], *z = x->filhos[i + 1];
+
+    memcpy(arvoreb_reg(t, y, y->quantidade), arvoreb_reg(t, x, i), e);
+    memcpy(arvoreb_reg(t, y, y->quantidade + 1), arvoreb_reg(t, z, 0), (size_t)z->quantidade * e);
+    if (!y->folha)
+        memcpy(y->filhos + y->quantidade + 1, z->filhos, (size_t)(z->quantidade + 1) * sizeof(NoArvoreB *));
+    y->quantidade += z->quantidade + 1;
+
+    memmove(arvoreb_reg(t, x, i), arvoreb_reg(t, x, i + 1), (size_t)(x->quantidade - i - 1) * e);
+    memmove(x->filhos + i + 1, x->filhos + i + 2, (size_t)(x->quantidade - i - 1) * sizeof(NoArvoreB *));
+    x->quantidade--;
+    pool_devolver(&t->pool, z);
+}
+
+// Deixa x->filhos[i] com pelo menos t registros (empresta de um irmão ou
+// funde) e devolve o índice do filho onde a busca continua
+static inline int arvoreb_reforcar(ArvoreB *t, NoArvoreB *x, int i) {
+    const int T = ARVOREB_GRAU;
+    size_t e = t->tamElem;
+    NoArvoreB *c = x->filhos[i];
+
+    if (i > 0 && x->filhos[i - 1]->quantidade >= T) {
+        // rotação pela esquerda
+        NoArvoreB *esq = x->filhos[i - 1];
+        memmove(arvoreb_reg(t, c, 1), arvoreb_reg(t, c, 0), (size_t)c->quantidade * e);
+        if (!c->folha) memmove(c->filhos + 1, c->filhos, (size_t)(c->quantidade + 1) * sizeof(NoArvoreB *));
+        memcpy(arvoreb_reg(t, c, 0), arvoreb_reg(t, x, i - 1), e);
+        if (!c->folha) c->filhos[0] = esq->filhos[esq->quantidade];
+        memcpy(arvoreb_reg(t, x, i - 1), arvoreb_reg(t, esq, esq->quantidade - 1), e);
+        esq->quantidade--;
+        c->quantidade++;
+        return i;
+    }
+    if (i < x->quantidade && x->filhos[i + 1]->quantidade >= T) {
+        // rotação pela direita
+        NoArvoreB *dir = x->filhos[i + 1];
+        memcpy(arvoreb_reg(t, c, c->quantidade), arvoreb_reg(t, x, i), e);
+        if (!c->folha) c->filhos[c->quantidade + 1] = dir->filhos[0];
+        memcpy(arvoreb_reg(t, x, i), arvoreb_reg(t, dir, 0), e);
+        memmove(arvoreb_reg(t, dir, 0), arvoreb_reg(t, dir, 1), (size_t)(dir->quantidade - 1) * e);
+        if (!dir->folha) memmove(dir->filhos, dir->filhos + 1, (size_t)dir->quantidade * sizeof(NoArvoreB *));
+        dir->quantidade--;
+        c->quantidade++;
+        return i;
+    }
+    if (i < x->quantidade) {
+        arvoreb_fundir(t, x, i);
+        return i;
+    }
+    arvoreb_fundir(t, x, i - 1);
+    return i - 1;
+}
+
+static inline int arvoreb_removerEm(ArvoreB *t, NoArvoreB *x, const void *chave, void *removido) {
+    const int T = ARVOREB_GRAU;
+    size_t e = t->tamElem;
+
+    while (1) {
+        int i = arvoreb_posicao(t, x, chave, 0);
+        int achou = i < x->quantidade && arvoreb_cmp(t, arvoreb_reg(t, x, i), chave) == 0;
+
+        if (achou && x->folha) {
+            if (removido) memcpy(removido, arvoreb_reg(t, x, i), e);
+            memmove(arvoreb_reg(t, x, i), arvoreb_reg(t, x, i + 1), (size_t)(x->quantidade - i - 1) * e);
+            x->quantidade--;
+            return 1;
+        }
+        if (achou) {
+            NoArvoreB *y = x->filhos[i], *z = x->filhos[i + 1];
+            if (y->quantidade >= T || z->quantidade >= T) {
+                // troca pelo antecessor (ou sucessor) e remove-o da subárvore
+                char substituto[e];
+                NoArvoreB *s = y->quantidade >= T ? y : z;
+                NoArvoreB *f = s;
+                if (s == y) { while (!f->folha) f = f->filhos[f->quantidade]; }
+                else { while (!f->folha) f = f->filhos[0]; }
+                memcpy(substituto, arvoreb_reg(t, f, s == y ? f->quantidade - 1 : 0), e);
+                if (removido) memcpy(removido, arvoreb_reg(t, x, i), e);
+                memcpy(arvoreb_reg(t, x, i), substituto, e);
+                return arvoreb_removerEm(t, s, substituto, NULL);
+            }
+            arvoreb_fundir(t, x, i);
+            x = y;
+            continue;
+        }
+        if (x->folha) return 0;
+        if (x->filhos[i]->quantidade < T) i = arvoreb_reforcar(t, x, i);
+        x = x->filhos[i];
+    }
+}
+
+// Remove o registro igual a 'chave' (copiado em 'removido', se não NULL).
+// Devolve 1 se removeu.
+static inline int arvoreb_remover(ArvoreB *t, const void *chave, void *removido) {
+    if (t->raiz == NULL) return 0;
+    int ok = arvoreb_removerEm(t, t->raiz, chave, removido);
+    if (t->raiz->quantidade == 0) {
+        NoArvoreB *velha = t->raiz;
+        t->raiz = velha->folha ? NULL : velha->filhos[0];
+        pool_devolver(&t->pool, velha);
+    }
+    if (ok) t->tamanho--;
+    return ok;
+}
+
+// -----------------------------
+// Consultas
+// -----------------------------
+
+// Menor registro >= sonda (NULL se não houver)
+static inline void *arvoreb_limiteInferior(ArvoreB *t, const void *sonda) {
+    void *melhor = NULL;
+    NoArvoreB *x = t->raiz;
+    while (x != NULL) {
+        int i = arvoreb_posicao(t, x, sonda, 0);
+        if (i < x->quantidade) melhor = arvoreb_reg(t, x, i);
+        x = x->folha ? NULL : x->filhos[i];
+    }
+    return melhor;
+}
+
+static inline int arvoreb_percorrer(ArvoreB *t, NoArvoreB *x, const void *min, const void *max,
+                                    VisitaRegistro visita, void *contexto) {
+    int i = min ? arvoreb_posicao(t, x, min, 0) : 0;
+    for (; i <= x->quantidade; i++) {
+        if (!x->folha && !arvoreb_percorrer(t, x->filhos[i], min, max, visita, contexto)) return 0;
+        if (i == x->quantidade) break;
+        char *r = arvoreb_reg(t, x, i);
+        if (max && arvoreb_cmp(t, r, max) > 0) return 0;
+        if (!visita(r, contexto)) return 0;
+    }
+    return 1;
+}
+
+// Visita em ordem os registros r com min <= r <= max (NULL: sem limite)
+static inline void arvoreb_intervalo(ArvoreB *t, const void *min, const void *max,
+                                     VisitaRegistro visita, void *contexto) {
+    if (t->raiz != NULL) arvoreb_percorrer(t, t->raiz, min, max, visita, contexto);
+}
+
+static inline int arvoreb_altura(const ArvoreB *t) {
+    int h = 0;
+    for (NoArvoreB *x = t->raiz; x != NULL; x = x->folha ? NULL : x->filhos[0]) h++;
+    return h;
+}
+
+#endif
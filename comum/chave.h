@@ -0,0 +1,163 @@
+/* chave.h
+ *
+ * Comparação de textos guardados em campos de largura fixa (nome[30],
+ * tipo[20]...). Todo campo tem um '\0' dentro da largura, então o campo
+ * pode ser lido inteiro: com SSE2 são 16 bytes por instrução, e o último
+ * bloco se sobrepõe ao anterior em vez de passar do fim do campo. Sem
+ * SSE2 o caminho é o escalar (strncmp/memcmp). AVX2 não compensa aqui: um
+ * bloco de 32 bytes já passaria do fim de nome[30].
+ *
+ * chave_comparar() ordena como strcmp. Para buscas por igualdade a chave
+ * é preparada uma vez (ChaveBusca, completada com zeros) e cada campo
+ * custa uma ou duas comparações de 16 bytes, sem procurar pelo '\0'.
+ *
+ * chave_faixaPrefixo() acha, num vetor ordenado, a faixa contígua de campos
+ * que começam com um prefixo (autocompletar): duas buscas binárias que só
+ * olham os bytes do prefixo.
+ */
+
+#ifndef FREEFIRE_CHAVE_H
+#define FREEFIRE_CHAVE_H
+
+#include <string.h>
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#include <emmintrin.h>
+#define CHAVE_TEM_SSE2 1
+#else
+#define CHAVE_TEM_SSE2 0
+#endif
+
+#define CHAVE_LARGURA_MAXIMA 32 // maior campo coberto por dois blocos de 16
+
+// Compara dois campos de 'largura' bytes: <0, 0 ou >0, como strcmp
+static inline int chave_comparar(const char *a, const char *b, size_t largura) {
+#if CHAVE_TEM_SSE2
+    if (largura >= 16) {
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (;;) {
+            __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+            __m128i y = _mm_loadu_si128((const __m128i *)(b + i));
+            // bytes diferentes ou fim do texto de 'a' (onde são iguais, acabam juntos)
+            unsigned m = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & 0xFFFFu;
+            m |= (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, zero));
+            if (m != 0) {
+                size_t k = i + (size_t)__builtin_ctz(m);
+                return (unsigned char)a[k] - (unsigned char)b[k];
+            }
+            if (i + 16 >= largura) return 0;
+            i = i + 32 <= largura ? i + 16 : largura - 16; // último bloco sobreposto
+        }
+    }
+#endif
+    return strncmp(a, b, largura);
+}
+
+// Chave de busca por igualdade, preparada uma vez por consulta
+typedef struct {
+    char texto[CHAVE_LARGURA_MAXIMA]; // completado com zeros
+    size_t largura;                   // largura do campo (até CHAVE_LARGURA_MAXIMA)
+    size_t tamanho;                   // bytes que precisam bater: texto e o '\0'
+} ChaveBusca;
+
+// Uma chave maior que o campo é guardada cortada: ainda ordena certo
+// contra os campos em chave_comparar, mas nunca é igual a nenhum deles
+static inline void chave_preparar(ChaveBusca *k, const char *texto, size_t largura) {
+    size_t len = strlen(texto);
+    memset(k->texto, 0, sizeof(k->texto));
+    memcpy(k->texto, texto, len < largura ? len : largura);
+    k->largura = largura;
+    k->tamanho = len + 1;
+}
+
+#if CHAVE_TEM_SSE2
+// Bits do movemask que correspondem aos primeiros 'bytes' do bloco
+static inline unsigned chave_mascara(size_t bytes) {
+    return bytes >= 16 ? 0xFFFFu : (1u << bytes) - 1u;
+}
+#endif
+
+// O campo tem exatamente o texto da chave?
+static inline int chave_igual(const char *campo, const ChaveBusca *k) {
+    if (k->tamanho > k->largura) return 0;
+#if CHAVE_TEM_SSE2
+    if (k->largura >= 16) {
+        unsigned r = chave_mascara(k->tamanho);
+        __m128i x = _mm_loadu_si128((const __m128i *)campo);
+        __m128i y = _mm_loadu_si128((const __m128i *)k->texto);
+        if (((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & r) != r) return 0;
+        if (k->tamanho <= 16) return 1;
+        size_t d = k->largura - 16;
+        r = chave_mascara(k->tamanho - d);
+        x = _mm_loadu_si128((const __m128i *)(campo + d));
+        y = _mm_loadu_si128((const __m128i *)(k->texto + d));
+        return ((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & r) == r;
+    }
+#endif
+    return memcmp(campo, k->texto, k->tamanho) == 0;
+}
+
+// Varredura sequencial: primeiro de 'n' campos, espaçados de 'passo'
+// bytes (um vetor de registros ou uma coluna), igual à chave; -1 se nenhum
+static inline int chave_procurar(const void *campos, size_t passo, int n, const ChaveBusca *k) {
+    const char *p = (const char *)campos;
+    if (k->tamanho > k->largura) return -1;
+#if CHAVE_TEM_SSE2
+    if (k->largura >= 16) {
+        // chave e máscaras ficam em registradores durante a varredura
+        size_t d = k->largura - 16;
+        unsigned r0 = chave_mascara(k->tamanho);
+        unsigned r1 = k->tamanho > 16 ? chave_mascara(k->tamanho - d) : 0;
+        __m128i y0 = _mm_loadu_si128((const __m128i *)k->texto);
+        __m128i y1 = _mm_loadu_si128((const __m128i *)(k->texto + d));
+        for (int i = 0; i < n; i++, p += passo) {
+            __m128i x0 = _mm_loadu_si128((const __m128i *)p);
+            if (((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x0, y0)) & r0) != r0) continue;
+            if (r1 == 0) return i;
+            __m128i x1 = _mm_loadu_si128((const __m128i *)(p + d));
+            if (((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x1, y1)) & r1) == r1) return i;
+        }
+        return -1;
+    }
+#endif
+    for (int i = 0; i < n; i++, p += passo) {
+        if (memcmp(p, k->texto, k->tamanho) == 0) return i;
+    }
+    return -1;
+}
+
+// Faixa dos 'n' campos ordenados (espaçados de 'passo' bytes) que começam
+// com 'prefixo': devolve quantos são e põe o primeiro em *inicio. Cada
+// passo das buscas compara só strlen(prefixo) bytes; *comparacoes recebe
+// os passos. O prefixo vazio casa com todos.
+static inline int chave_faixaPrefixo(const void *campos, size_t passo, int n, size_t largura, const char *prefixo,
+                                     int *inicio, long *comparacoes) {
+    const char *p = (const char *)campos;
+    size_t len = strlen(prefixo);
+    *inicio = 0;
+    *comparacoes = 0;
+    if (len >= largura) return 0; // nenhum campo tem espaço para o prefixo e o '\0'
+
+    // primeiro campo >= prefixo (nos primeiros len bytes)
+    int ini = 0, fim = n;
+    while (ini < fim) {
+        int meio = ini + (fim - ini) / 2;
+        (*comparacoes)++;
+        if (strncmp(p + (size_t)meio * passo, prefixo, len) < 0) ini = meio + 1;
+        else fim = meio;
+    }
+    *inicio = ini;
+
+    // primeiro campo depois dele que já não começa com o prefixo
+    fim = n;
+    while (ini < fim) {
+        int meio = ini + (fim - ini) / 2;
+        (*comparacoes)++;
+        if (strncmp(p + (size_t)meio * passo, prefixo, len) == 0) ini = meio + 1;
+        else fim = meio;
+    }
+    return ini - *inicio;
+}
+
+#endif
@@ -0,0 +1,101 @@
+/* chavenormal.h
+ *
+ * Chaves normalizadas para ordenar por vários campos de uma vez. Cada
+ * registro é codificado uma única vez numa sequência de bytes em que a
+ * ordem de memcmp é a ordem desejada: inteiros em big-endian com o bit de
+ * sinal invertido, textos completados com zeros até a largura do campo, e
+ * um campo decrescente tem todos os bytes invertidos (~). Os campos vão
+ * um atrás do outro, do critério principal para o desempate.
+ *
+ * Assim a comparação de (tipo, prioridade decrescente, nome) deixa de ser
+ * uma cadeia de comparadores com desvios a cada passo e vira um memcmp de
+ * largura fixa. chavenormal_ordenar() ordena uma permutação por essas
+ * chaves (Merge Sort estável, como ordenacao_mergesort).
+ */
+
+#ifndef FREEFIRE_CHAVENORMAL_H
+#define FREEFIRE_CHAVENORMAL_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ordenacao.h"
+
+// Inteiro com sinal em 4 bytes: -2^31 vira 00 00 00 00, 2^31-1 vira FF FF FF FF
+static inline unsigned char *chavenormal_inteiro(unsigned char *p, int v, int decrescente) {
+    uint32_t u = (uint32_t)v ^ 0x80000000u;
+    if (decrescente) u = ~u;
+    p[0] = (unsigned char)(u >> 24);
+    p[1] = (unsigned char)(u >> 16);
+    p[2] = (unsigned char)(u >> 8);
+    p[3] = (unsigned char)u;
+    return p + 4;
+}
+
+// Natural até 0xFFFF em 2 bytes (ids e posições de dicionário)
+static inline unsigned char *chavenormal_natural16(unsigned char *p, unsigned v, int decrescente) {
+    uint16_t u = (uint16_t)v;
+    if (decrescente) u = (uint16_t)~u;
+    p[0] = (unsigned char)(u >> 8);
+    p[1] = (unsigned char)u;
+    return p + 2;
+}
+
+// Texto em 'largura' bytes, completado com zeros: ordena como strcmp
+// enquanto nenhum texto passar da largura
+static inline unsigned char *chavenormal_texto(unsigned char *p, const char *texto, size_t largura, int decrescente) {
+    const char *fimTexto = (const char *)memchr(texto, '\0', largura);
+    size_t len = fimTexto != NULL ? (size_t)(fimTexto - texto) : largura;
+    memcpy(p, texto, len);
+    memset(p + len, 0, largura - len);
+    if (decrescente)
+        for (size_t i = 0; i < largura; i++) p[i] = (unsigned char)~p[i];
+    return p + largura;
+}
+
+static inline int chavenormal_comparar(const unsigned char *chaves, size_t largura, int a, int b, long *comparacoes) {
+    (*comparacoes)++;
+    return memcmp(chaves + (size_t)a * largura, chaves + (size_t)b * largura, largura);
+}
+
+// Ordena perm[0..n) pelas chaves de 'largura' bytes (chaves[i] é a do
+// registro i), de forma estável: trechos pequenos por inserção, depois
+// intercalações de baixo para cima alternando entre perm e um auxiliar.
+// Devolve o número de comparações (memcmp).
+static inline long chavenormal_ordenar(const unsigned char *chaves, size_t largura, int *perm, int n) {
+    long comparacoes = 0;
+    if (n < 2) return 0;
+    for (int ini = 0; ini < n; ini += ORDENACAO_CORTE_INSERCAO) {
+        int fim = ini + ORDENACAO_CORTE_INSERCAO < n ? ini + ORDENACAO_CORTE_INSERCAO : n;
+        for (int i = ini + 1; i < fim; i++) {
+            int v = perm[i], j = i - 1;
+            while (j >= ini && chavenormal_comparar(chaves, largura, perm[j], v, &comparacoes) > 0) {
+                perm[j + 1] = perm[j];
+                j--;
+            }
+            perm[j + 1] = v;
+        }
+    }
+    if (n <= ORDENACAO_CORTE_INSERCAO) return comparacoes;
+
+    int *aux = (int *)ordenacao_alocar((size_t)n * sizeof(int));
+    int *de = perm, *para = aux;
+    for (int largo = ORDENACAO_CORTE_INSERCAO; largo < n; largo *= 2) {
+        for (int ini = 0; ini < n; ini += 2 * largo) {
+            int meio = ini + largo < n ? ini + largo : n;
+            int fim = ini + 2 * largo < n ? ini + 2 * largo : n;
+            int i = ini, j = meio, k = ini;
+            while (i < meio && j < fim)
+                para[k++] = chavenormal_comparar(chaves, largura, de[j], de[i], &comparacoes) < 0 ? de[j++] : de[i++];
+            while (i < meio) para[k++] = de[i++];
+            while (j < fim) para[k++] = de[j++];
+        }
+        int *t = de; de = para; para = t;
+    }
+    if (de != perm) memcpy(perm, de, (size_t)n * sizeof(int));
+    free(aux);
+    return comparacoes;
+}
+
+#endif
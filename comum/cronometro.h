@@ -0,0 +1,210 @@
+/* cronometro.h
+ *
+ * Medição de tempo de alta resolução e histogramas por tipo de operação.
+ * Usa CLOCK_MONOTONIC (nanossegundos) e, em x86, o contador de ciclos da
+ * CPU (rdtsc) como medida complementar.
+ *
+ * Cada Histograma acumula amostras em faixas logarítmicas (4 subfaixas por
+ * potência de 2, erro relativo < 19%) e guarda contagem, soma, mínimo e
+ * máximo exatos. Os percentis são estimados pelo ponto médio da faixa.
+ */
+
+#ifndef FREEFIRE_CRONOMETRO_H
+#define FREEFIRE_CRONOMETRO_H
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CRONOMETRO_TEM_CICLOS 1
+#else
+#define CRONOMETRO_TEM_CICLOS 0
+#endif
+
+#define HISTOGRAMA_SUBFAIXAS 4
+#define HISTOGRAMA_FAIXAS (64 * HISTOGRAMA_SUBFAIXAS)
+
+typedef struct {
+    const char *nome;
+    long long contagem;
+    long long somaNs;
+    long long minNs;
+    long long maxNs;
+    unsigned long long somaCiclos;
+    long long faixas[HISTOGRAMA_FAIXAS];
+} Histograma;
+
+// Início de uma medição
+typedef struct {
+    long long ns;
+    unsigned long long ciclos;
+} Medicao;
+
+// Desligado, medicao_* não lê o relógio (o benchmark mede por fora)
+static int cronometro_ativo = 1;
+
+static inline long long cronometro_agoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static inline unsigned long long cronometro_ciclos(void) {
+#if CRONOMETRO_TEM_CICLOS
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Formata uma duração em ns com a unidade adequada (ns, µs, ms, s)
+static inline const char *cronometro_formatar(char *buf, size_t tam, long long ns) {
+    if (ns < 1000) snprintf(buf, tam, "%lld ns", ns);
+    else if (ns < 1000000) snprintf(buf, tam, "%.3f µs", ns / 1e3);
+    else if (ns < 1000000000) snprintf(buf, tam, "%.3f ms", ns / 1e6);
+    else snprintf(buf, tam, "%.3f s", ns / 1e9);
+    return buf;
+}
+
+// Igual a cronometro_formatar, com buffers internos em rodízio (até 8
+// durações no mesmo printf)
+static inline const char *cronometro_texto(long long ns) {
+    static char bufs[8][32];
+    static int proximo = 0;
+    char *b = bufs[proximo];
+    proximo = (proximo + 1) % 8;
+    return cronometro_formatar(b, sizeof(bufs[0]), ns);
+}
+
+// -----------------------------
+// Histograma
+// -----------------------------
+
+static inline void histograma_iniciar(Histograma *h, const char *nome) {
+    memset(h, 0, sizeof(*h));
+    h->nome = nome;
+}
+
+// Faixa de um valor: 4 subfaixas por potência de 2
+static inline int histograma_faixa(long long ns) {
+    if (ns < HISTOGRAMA_SUBFAIXAS) return ns < 0 ? 0 : (int)ns;
+    int log2 = 63 - __builtin_clzll((unsigned long long)ns);
+    int sub = (int)((ns >> (log2 - 2)) & (HISTOGRAMA_SUBFAIXAS - 1));
+    return (log2 - 1) * HISTOGRAMA_SUBFAIXAS + sub;
+}
+
+// Limite inferior da faixa i (inverso de histograma_faixa)
+static inline long long histograma_limite(int i) {
+    if (i < HISTOGRAMA_SUBFAIXAS) return i;
+    int log2 = i / HISTOGRAMA_SUBFAIXAS + 1;
+    int sub = i % HISTOGRAMA_SUBFAIXAS;
+    return (long long)(HISTOGRAMA_SUBFAIXAS + sub) << (log2 - 2);
+}
+
+static inline void histograma_registrar(Histograma *h, long long ns, unsigned long long ciclos) {
+    if (h->contagem == 0 || ns < h->minNs) h->minNs = ns;
+    if (ns > h->maxNs) h->maxNs = ns;
+    h->contagem++;
+    h->somaNs += ns;
+    h->somaCiclos += ciclos;
+    h->faixas[histograma_faixa(ns)]++;
+}
+
+// Percentil aproximado (p em 0..100)
+static inline long long histograma_percentil(const Histograma *h, double p) {
+    if (h->contagem == 0) return 0;
+    long long alvo = (long long)(p / 100.0 * (double)h->contagem + 0.5);
+    if (alvo < 1) alvo = 1;
+    long long acumulado = 0;
+    for (int i = 0; i < HISTOGRAMA_FAIXAS; i++) {
+        acumulado += h->faixas[i];
+        if (acumulado >= alvo) {
+            long long meio = (histograma_limite(i) + histograma_limite(i + 1)) / 2;
+            if (meio < h->minNs) meio = h->minNs;
+            if (meio > h->maxNs) meio = h->maxNs;
+            return meio;
+        }
+    }
+    return h->maxNs;
+}
+
+// -----------------------------
+// Medições
+// -----------------------------
+
+static inline Medicao medicao_iniciar(void) {
+    Medicao m = { 0, 0 };
+    if (cronometro_ativo) {
+        m.ciclos = cronometro_ciclos();
+        m.ns = cronometro_agoraNs();
+    }
+    return m;
+}
+
+// Encerra a medição, registra no histograma (se houver) e devolve os ns
+static inline long long medicao_registrar(const Medicao *m, Histograma *h) {
+    if (!cronometro_ativo) return 0;
+    long long ns = cronometro_agoraNs() - m->ns;
+    unsigned long long ciclos = cronometro_ciclos() - m->ciclos;
+    if (h != NULL) histograma_registrar(h, ns, ciclos);
+    return ns;
+}
+
+// Imprime 's' em 'largura' colunas contando caracteres UTF-8, não bytes,
+// para acentos e "µs" não desalinharem a tabela. Largura negativa alinha
+// à direita.
+static inline void cronometro_coluna(const char *s, int largura) {
+    int cols = 0;
+    for (const char *p = s; *p; p++) if (((unsigned char)*p & 0xC0) != 0x80) cols++;
+    int direita = largura < 0;
+    if (direita) largura = -largura;
+    int sobra = largura > cols ? largura - cols : 0;
+    if (direita) printf("%*s%s", sobra, "", s);
+    else printf("%s%*s", s, sobra, "");
+}
+
+// Tabela com uma linha por operação que tenha amostras
+static inline void histograma_imprimirTabela(const Histograma *hs, int n) {
+    const char *titulos[] = { "Mínimo", "Média", "p50", "p99", "Máximo" };
+    cronometro_coluna("Operação", 28);
+    printf(" | %9s", "Qtd");
+    for (int c = 0; c < 5; c++) { printf(" | "); cronometro_coluna(titulos[c], -12); }
+    if (CRONOMETRO_TEM_CICLOS) printf(" | %12s", "Ciclos/op");
+    printf("\n");
+    int algum = 0;
+    for (int i = 0; i < n; i++) {
+        const Histograma *h = &hs[i];
+        if (h->contagem == 0) continue;
+        algum = 1;
+        long long valores[5] = { h->minNs, h->somaNs / h->contagem, histograma_percentil(h, 50),
+                                 histograma_percentil(h, 99), h->maxNs };
+        cronometro_coluna(h->nome, 28);
+        printf(" | %9lld", h->contagem);
+        for (int c = 0; c < 5; c++) { printf(" | "); cronometro_coluna(cronometro_texto(valores[c]), -12); }
+        if (CRONOMETRO_TEM_CICLOS) printf(" | %12llu", h->somaCiclos / (unsigned long long)h->contagem);
+        printf("\n");
+    }
+    if (!algum) printf("Nenhuma operação medida ainda.\n");
+}
+
+// Distribuição de um histograma em barras (só as faixas não vazias)
+static inline void histograma_imprimirBarras(const Histograma *h) {
+    char a[32], b[32];
+    long long maior = 0;
+    for (int i = 0; i < HISTOGRAMA_FAIXAS; i++) if (h->faixas[i] > maior) maior = h->faixas[i];
+    if (maior == 0) return;
+    printf("\nDistribuição: %s\n", h->nome);
+    for (int i = 0; i < HISTOGRAMA_FAIXAS; i++) {
+        if (h->faixas[i] == 0) continue;
+        int largura = (int)(h->faixas[i] * 40 / maior);
+        cronometro_coluna(cronometro_formatar(a, sizeof(a), histograma_limite(i)), -12);
+        printf(" - ");
+        cronometro_coluna(cronometro_formatar(b, sizeof(b), histograma_limite(i + 1)), 12);
+        printf(" | %-40.*s %lld\n", largura > 0 ? largura : 1,
+               "########################################", h->faixas[i]);
+    }
+}
+
+#endif
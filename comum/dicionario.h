@@ -0,0 +1,163 @@
+/* dicionario.h
+ *
+ * Dicionário de textos curtos que se repetem muito (os tipos: "arma",
+ * "municao", "cura"...). Cada texto distinto é guardado uma vez e ganha um
+ * id pequeno (uint16_t), na ordem de chegada; os registros guardam só o id.
+ *
+ * Ordenar pelo texto não exige comparar textos: ordem[id] é a posição do
+ * texto na ordem alfabética, refeita a cada texto novo (são poucos textos
+ * para muitos registros). Comparar dois ids vira comparar dois inteiros, e
+ * a posição alfabética serve de chave para um counting sort.
+ *
+ * Os textos ficam num vetor contíguo de DICIONARIO_TEXTO bytes cada,
+ * completados com zeros, que pode ser gravado e recarregado como está.
+ */
+
+#ifndef FREEFIRE_DICIONARIO_H
+#define FREEFIRE_DICIONARIO_H
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "chave.h"
+#include "indice.h"
+
+#define DICIONARIO_TEXTO 20
+#define DICIONARIO_MAXIMO 0xFFFE // ids válidos: 0 .. MAXIMO-1
+#define DICIONARIO_ANTES 0xFFFE  // id de sonda: antes de todos os textos
+#define DICIONARIO_DEPOIS 0xFFFF // id de sonda: depois de todos
+#define DICIONARIO_CAP_INICIAL 16
+
+typedef struct {
+    char (*textos)[DICIONARIO_TEXTO]; // textos[id]
+    int *ordem;                       // ordem[id]: posição na ordem alfabética
+    uint16_t *porOrdem;               // porOrdem[k]: id do k-ésimo texto em ordem
+    int *tabela;                      // hash (sondagem linear): id ou -1
+    int capTabela;                    // potência de 2, mais que o dobro da quantidade
+    int quantidade;
+    int capacidade;
+} Dicionario;
+
+static inline void *dicionario_alocar(void *antigo, size_t bytes) {
+    void *p = realloc(antigo, bytes);
+    if (p == NULL) {
+        fprintf(stderr, "Memória insuficiente (dicionário).\n");
+        exit(1);
+    }
+    return p;
+}
+
+static inline void dicionario_refazerTabela(Dicionario *d, int capTabela) {
+    d->tabela = (int *)dicionario_alocar(d->tabela, (size_t)capTabela * sizeof(int));
+    d->capTabela = capTabela;
+    for (int i = 0; i < capTabela; i++) d->tabela[i] = -1;
+    for (int id = 0; id < d->quantidade; id++) {
+        int i = (int)(indice_hash(d->textos[id]) & (uint32_t)(capTabela - 1));
+        while (d->tabela[i] >= 0) i = (i + 1) & (capTabela - 1);
+        d->tabela[i] = id;
+    }
+}
+
+static inline void dicionario_iniciar(Dicionario *d) {
+    memset(d, 0, sizeof(*d));
+    dicionario_refazerTabela(d, DICIONARIO_CAP_INICIAL * 2);
+}
+
+static inline void dicionario_liberar(Dicionario *d) {
+    free(d->textos);
+    free(d->ordem);
+    free(d->porOrdem);
+    free(d->tabela);
+    memset(d, 0, sizeof(*d));
+}
+
+// Copia 'texto' para um campo de DICIONARIO_TEXTO bytes (cortado e completado com zeros)
+static inline void dicionario_normalizar(char campo[DICIONARIO_TEXTO], const char *texto) {
+    size_t len = strlen(texto);
+    if (len > DICIONARIO_TEXTO - 1) len = DICIONARIO_TEXTO - 1;
+    memset(campo, 0, DICIONARIO_TEXTO);
+    memcpy(campo, texto, len);
+}
+
+// Espaço da tabela com o texto (campo normalizado) ou o vazio onde entraria
+static inline int dicionario_espaco(const Dicionario *d, const char *campo) {
+    int mascara = d->capTabela - 1;
+    int i = (int)(indice_hash(campo) & (uint32_t)mascara);
+    while (d->tabela[i] >= 0 && memcmp(d->textos[d->tabela[i]], campo, DICIONARIO_TEXTO) != 0)
+        i = (i + 1) & mascara;
+    return i;
+}
+
+// Id do texto, ou -1 se ele nunca foi internado
+static inline int dicionario_buscar(const Dicionario *d, const char *texto) {
+    if (d->quantidade == 0) return -1;
+    char campo[DICIONARIO_TEXTO];
+    dicionario_normalizar(campo, texto);
+    return d->tabela[dicionario_espaco(d, campo)];
+}
+
+// Id do texto, criado se for novo. Retorna -1 se o dicionário está cheio.
+static inline int dicionario_internar(Dicionario *d, const char *texto) {
+    if (d->tabela == NULL) dicionario_iniciar(d); // dicionário estático ainda zerado
+    char campo[DICIONARIO_TEXTO];
+    dicionario_normalizar(campo, texto);
+    int i = dicionario_espaco(d, campo);
+    if (d->tabela[i] >= 0) return d->tabela[i];
+    if (d->quantidade >= DICIONARIO_MAXIMO) return -1;
+
+    if (d->quantidade == d->capacidade) {
+        int cap = d->capacidade ? d->capacidade * 2 : DICIONARIO_CAP_INICIAL;
+        if (cap > DICIONARIO_MAXIMO) cap = DICIONARIO_MAXIMO;
+        d->textos = (char (*)[DICIONARIO_TEXTO])dicionario_alocar(d->textos, (size_t)cap * DICIONARIO_TEXTO);
+        d->ordem = (int *)dicionario_alocar(d->ordem, (size_t)cap * sizeof(int));
+        d->porOrdem = (uint16_t *)dicionario_alocar(d->porOrdem, (size_t)cap * sizeof(uint16_t));
+        d->capacidade = cap;
+    }
+    int id = d->quantidade++;
+    memcpy(d->textos[id], campo, DICIONARIO_TEXTO);
+
+    // posição alfabética por busca binária; os que vêm depois andam uma casa
+    int ini = 0, fim = id;
+    while (ini < fim) {
+        int meio = ini + (fim - ini) / 2;
+        if (chave_comparar(d->textos[d->porOrdem[meio]], campo, DICIONARIO_TEXTO) < 0) ini = meio + 1;
+        else fim = meio;
+    }
+    memmove(&d->porOrdem[ini + 1], &d->porOrdem[ini], (size_t)(id - ini) * sizeof(uint16_t));
+    d->porOrdem[ini] = (uint16_t)id;
+    for (int k = ini; k <= id; k++) d->ordem[d->porOrdem[k]] = k;
+
+    if (d->quantidade * 2 > d->capTabela) dicionario_refazerTabela(d, d->capTabela * 2);
+    else d->tabela[i] = id;
+    return id;
+}
+
+static inline const char *dicionario_texto(const Dicionario *d, int id) {
+    return id >= 0 && id < d->quantidade ? d->textos[id] : "?";
+}
+
+// Posição alfabética do texto do id (as sondas ficam antes/depois de todos)
+static inline int dicionario_ordem(const Dicionario *d, int id) {
+    if (id < d->quantidade) return d->ordem[id];
+    return id == DICIONARIO_ANTES ? -1 : INT_MAX;
+}
+
+// Preenche um dicionário recém-iniciado com 'n' textos gravados (textos[id]).
+// Retorna 0 se algum texto não termina dentro do campo ou se repete
+// (o dicionário fica vazio).
+static inline int dicionario_carregar(Dicionario *d, const void *textos, int n) {
+    const char (*t)[DICIONARIO_TEXTO] = (const char (*)[DICIONARIO_TEXTO])textos;
+    for (int id = 0; id < n; id++) {
+        if (memchr(t[id], '\0', DICIONARIO_TEXTO) == NULL || dicionario_internar(d, t[id]) != id) {
+            dicionario_liberar(d);
+            dicionario_iniciar(d);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#endif
@@ -0,0 +1,226 @@
+/* entrada.h
+ *
+ * Leitura de entrada por linhas, compartilhada pelos três níveis (menus e
+ * modo lote). Lê blocos grandes (ENTRADA_BUFFER) direto do descritor,
+ * separa as linhas com memchr e entrega cada uma no próprio buffer,
+ * terminada em '\0', sem cópia. Inteiros e textos são convertidos à mão,
+ * com tamanho máximo: nada de scanf/sscanf.
+ *
+ * A linha devolvida vale até a próxima chamada de entrada_linha().
+ * Linhas maiores que o buffer são cortadas (o resto é descartado).
+ *
+ * Em terminal, read() devolve uma linha por vez e a leitura continua
+ * interativa; antes de esperar pelo teclado o stdout é esvaziado, para o
+ * prompt aparecer. entrada_aguardar() espera por uma linha com prazo, sem
+ * consumi-la (para quem tem trabalho a fazer se a entrada demorar).
+ */
+
+#ifndef FREEFIRE_ENTRADA_H
+#define FREEFIRE_ENTRADA_H
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>
+#include <unistd.h>
+#define ENTRADA_TEM_READ 1
+#else
+#define ENTRADA_TEM_READ 0
+#endif
+
+#define ENTRADA_BUFFER (1 << 16)
+
+typedef struct {
+    FILE *arquivo;      // NULL: stdin
+    char *inicio;       // primeiro byte ainda não entregue
+    char *fim;          // fim dos dados lidos
+    int fimArquivo;
+    int descartando;    // pulando o resto de uma linha grande demais
+    long numLinha;
+    char buffer[ENTRADA_BUFFER + 1]; // +1: '\0' depois da última linha
+} LeitorEntrada;
+
+// Leitor do teclado (stdin) usado pelos menus
+static LeitorEntrada entrada_teclado;
+
+static inline void entrada_iniciar(LeitorEntrada *e, FILE *arquivo) {
+    e->arquivo = arquivo;
+    e->inicio = e->fim = e->buffer;
+    e->fimArquivo = 0;
+    e->descartando = 0;
+    e->numLinha = 0;
+}
+
+// Traz mais dados para depois dos que ainda não foram entregues
+static inline void entrada_recarregar(LeitorEntrada *e) {
+    size_t resto = (size_t)(e->fim - e->inicio);
+    if (e->inicio != e->buffer) memmove(e->buffer, e->inicio, resto);
+    e->inicio = e->buffer;
+    e->fim = e->buffer + resto;
+
+    FILE *f = e->arquivo != NULL ? e->arquivo : stdin;
+    if (f == stdin) fflush(stdout); // o prompt precisa estar na tela
+#if ENTRADA_TEM_READ
+    long n;
+    do {
+        n = (long)read(fileno(f), e->fim, ENTRADA_BUFFER - resto);
+    } while (n < 0 && errno == EINTR);
+#else
+    // sem read(): fgets devolve no máximo uma linha, o que mantém o
+    // terminal interativo
+    long n = 0;
+    if (fgets(e->fim, (int)(ENTRADA_BUFFER - resto + 1), f) != NULL) n = (long)strlen(e->fim);
+#endif
+    if (n <= 0) e->fimArquivo = 1;
+    else e->fim += n;
+}
+
+// Próxima linha, sem '\n' nem '\r' final; NULL quando a entrada acaba
+static inline char *entrada_linha(LeitorEntrada *e) {
+    if (e->inicio == NULL) entrada_iniciar(e, e->arquivo); // leitor estático ainda zerado
+    for (;;) {
+        char *nl = (char *)memchr(e->inicio, '\n', (size_t)(e->fim - e->inicio));
+        char *linha = e->inicio;
+        if (nl == NULL) {
+            if (e->fimArquivo) {
+                if (e->inicio == e->fim) return NULL;
+                nl = e->fim; // última linha sem '\n'
+                e->fim++;    // o '\0' ocupa o byte extra do buffer
+            } else if (e->inicio == e->buffer && e->fim == e->buffer + ENTRADA_BUFFER) {
+                // linha maior que o buffer: entrega o começo, descarta o resto
+                if (e->descartando) {
+                    e->inicio = e->fim;
+                    continue;
+                }
+                nl = e->fim - 1;
+                e->descartando = 2;
+            } else {
+                entrada_recarregar(e);
+                continue;
+            }
+        }
+        *nl = '\0';
+        e->inicio = nl + 1;
+        if (e->descartando == 1) { // fim de uma linha já entregue cortada
+            e->descartando = 0;
+            continue;
+        }
+        if (e->descartando == 2) e->descartando = 1;
+        size_t tam = (size_t)(nl - linha);
+        if (tam > 0 && linha[tam - 1] == '\r') linha[tam - 1] = '\0';
+        e->numLinha++;
+        return linha;
+    }
+}
+
+// Espera até 'ns' nanossegundos (arredondados para cima em ms) por uma
+// linha completa ou pelo fim da entrada, sem consumir nada. Devolve 1 se
+// há o que ler (entrada_linha não vai esperar), 0 se o prazo passou.
+// Sem poll() não há como esperar com prazo: devolve 1.
+static inline int entrada_aguardar(LeitorEntrada *e, long long ns) {
+    if (e->inicio == NULL) entrada_iniciar(e, e->arquivo);
+    if (e->fimArquivo || memchr(e->inicio, '\n', (size_t)(e->fim - e->inicio)) != NULL) return 1;
+#if ENTRADA_TEM_READ
+    FILE *f = e->arquivo != NULL ? e->arquivo : stdin;
+    struct pollfd p = { fileno(f), POLLIN, 0 };
+    long long ms = (ns + 999999) / 1000000;
+    int r;
+    do {
+        r = poll(&p, 1, ms < INT_MAX ? (int)ms : INT_MAX);
+    } while (r < 0 && errno == EINTR);
+    return r != 0;
+#else
+    (void)ns;
+    return 1;
+#endif
+}
+
+// A entrada acabou e não sobrou nada para entregar
+static inline int entrada_esgotada(const LeitorEntrada *e) {
+    return e->fimArquivo && e->inicio == e->fim;
+}
+
+static inline int entrada_espaco(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Próximo token separado por espaços a partir de *cursor (NULL se acabou).
+// Termina o token no lugar e avança o cursor.
+static inline char *entrada_token(char **cursor) {
+    char *p = *cursor;
+    while (entrada_espaco(*p)) p++;
+    if (*p == '\0') { *cursor = p; return NULL; }
+    char *inicio = p;
+    while (*p && !entrada_espaco(*p)) p++;
+    if (*p) *p++ = '\0';
+    *cursor = p;
+    return inicio;
+}
+
+// Converte um inteiro decimal (espaços em volta são aceitos).
+// Retorna 0 se não for um número inteiro válido.
+static inline int entrada_converterInteiro(const char *s, int *out) {
+    while (entrada_espaco(*s)) s++;
+    int negativo = *s == '-';
+    if (*s == '-' || *s == '+') s++;
+    if (*s < '0' || *s > '9') return 0;
+    long long v = 0;
+    while (*s >= '0' && *s <= '9') {
+        v = v * 10 + (*s++ - '0');
+        if (v > (long long)INT_MAX + 1) return 0;
+    }
+    while (entrada_espaco(*s)) s++;
+    if (*s != '\0') return 0;
+    if (negativo) v = -v;
+    if (v > INT_MAX) return 0;
+    *out = (int)v;
+    return 1;
+}
+
+// Copia 's' para 'out' (até maxlen-1 bytes, completando com zeros)
+static inline void entrada_copiarTexto(char *out, int maxlen, const char *s) {
+    size_t len = strlen(s);
+    if (len > (size_t)maxlen - 1) len = (size_t)maxlen - 1;
+    memcpy(out, s, len);
+    memset(out + len, 0, (size_t)maxlen - len);
+}
+
+// -----------------------------
+// Leitura com prompt (menus)
+// -----------------------------
+
+// Lê uma linha do teclado para 'out', sem espaços nas pontas.
+// Retorna 0 se a entrada acabou (out fica vazio).
+static inline int entrada_lerTexto(const char *prompt, char *out, int maxlen) {
+    printf("%s", prompt);
+    char *linha = entrada_linha(&entrada_teclado);
+    if (linha == NULL) {
+        memset(out, 0, (size_t)maxlen);
+        return 0;
+    }
+    while (entrada_espaco(*linha)) linha++;
+    size_t len = strlen(linha);
+    while (len > 0 && entrada_espaco(linha[len - 1])) linha[--len] = '\0';
+    entrada_copiarTexto(out, maxlen, linha);
+    return 1;
+}
+
+// Lê um inteiro do teclado, repetindo o prompt até ser válido.
+// Retorna 0 se a entrada acabou (e *out fica 0).
+static inline int entrada_lerInteiro(const char *prompt, int *out) {
+    for (;;) {
+        printf("%s", prompt);
+        char *linha = entrada_linha(&entrada_teclado);
+        if (linha == NULL) {
+            *out = 0;
+            return 0;
+        }
+        if (entrada_converterInteiro(linha, out)) return 1;
+        printf("Entrada inválida. Digite um número inteiro.\n");
+    }
+}
+
+#endif
@@ -0,0 +1,230 @@
+/* heap.h
+ *
+ * Fila de prioridade (heap 4-ário de máximo) de registros de tamanho fixo,
+ * guardados num Inventario. O topo, o registro que sai primeiro, é lido em
+ * O(1); inserir, retirar o topo e mudar a prioridade de um registro são
+ * O(log n). Com 4 filhos por nó a árvore tem metade da altura de um heap
+ * binário e os filhos de um nó ficam lado a lado na memória.
+ *
+ * Um IndiceNome (../comum/indice.h) acompanha cada troca de posição, para
+ * achar um registro pelo nome sem varrer o heap. Nomes repetidos são
+ * aceitos: heap_localizar() confere o registro inteiro.
+ *
+ * heap_selecionarK() resolve "os k primeiros" direto sobre um vetor, sem
+ * fila mantida: um heap de mínimo com k índices, O(n log k).
+ */
+
+#ifndef FREEFIRE_HEAP_H
+#define FREEFIRE_HEAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "inventario.h"
+#include "indice.h"
+
+#define HEAP_ARIDADE 4
+
+// >0 se 'a' sai antes de 'b' (tem mais prioridade), 0 se empatam, <0 depois
+typedef int (*ComparadorHeap)(const void *a, const void *b);
+
+typedef struct {
+    Arena arena;
+    Inventario registros; // filhos de i: HEAP_ARIDADE*i+1 .. HEAP_ARIDADE*i+HEAP_ARIDADE
+    IndiceNome indice;    // nome -> posição no heap
+    ComparadorHeap cmp;
+    long comparacoes;     // acumulado; quem mede zera antes
+} FilaPrioridade;
+
+static inline void heap_iniciar(FilaPrioridade *f, size_t tamElem, size_t offsetNome, ComparadorHeap cmp) {
+    arena_iniciar(&f->arena);
+    inventario_iniciar(&f->registros, &f->arena, tamElem);
+    indice_iniciar(&f->indice, &f->registros, offsetNome);
+    f->cmp = cmp;
+    f->comparacoes = 0;
+}
+
+static inline void heap_liberar(FilaPrioridade *f) {
+    indice_liberar(&f->indice);
+    arena_liberar(&f->arena);
+    inventario_iniciar(&f->registros, &f->arena, f->registros.tamElem);
+}
+
+static inline int heap_tamanho(const FilaPrioridade *f) {
+    return f->registros.tamanho;
+}
+
+// Registro que sai primeiro, ou NULL se a fila está vazia: O(1)
+static inline const void *heap_topo(const FilaPrioridade *f) {
+    return f->registros.tamanho > 0 ? inventario_em(&f->registros, 0) : NULL;
+}
+
+static inline int heap_cmp(FilaPrioridade *f, int a, int b) {
+    f->comparacoes++;
+    return f->cmp(inventario_em(&f->registros, a), inventario_em(&f->registros, b));
+}
+
+// Troca duas posições, levando junto as entradas do índice
+static inline void heap_trocar(FilaPrioridade *f, int a, int b) {
+    IndiceNome *idx = &f->indice;
+    // cada posição tem uma única entrada: acha as duas antes de mexer
+    int ea = indice_localizar(idx, indice_chave(idx, a), a, NULL);
+    int eb = indice_localizar(idx, indice_chave(idx, b), b, NULL);
+    char *x = (char *)inventario_em(&f->registros, a), *y = (char *)inventario_em(&f->registros, b);
+    char tmp[256];
+    for (size_t feito = 0; feito < f->registros.tamElem; feito += sizeof(tmp)) {
+        size_t n = f->registros.tamElem - feito < sizeof(tmp) ? f->registros.tamElem - feito : sizeof(tmp);
+        memcpy(tmp, x + feito, n);
+        memcpy(x + feito, y + feito, n);
+        memcpy(y + feito, tmp, n);
+    }
+    if (ea >= 0) idx->posicoes[ea] = b;
+    if (eb >= 0) idx->posicoes[eb] = a;
+}
+
+static inline int heap_subir(FilaPrioridade *f, int i) {
+    while (i > 0) {
+        int pai = (i - 1) / HEAP_ARIDADE;
+        if (heap_cmp(f, i, pai) <= 0) break;
+        heap_trocar(f, i, pai);
+        i = pai;
+    }
+    return i;
+}
+
+static inline int heap_descer(FilaPrioridade *f, int i) {
+    int n = f->registros.tamanho;
+    for (;;) {
+        int primeiro = HEAP_ARIDADE * i + 1;
+        if (primeiro >= n) break;
+        int ultimo = primeiro + HEAP_ARIDADE < n ? primeiro + HEAP_ARIDADE : n;
+        int maior = primeiro;
+        for (int c = primeiro + 1; c < ultimo; c++)
+            if (heap_cmp(f, c, maior) > 0) maior = c;
+        if (heap_cmp(f, maior, i) <= 0) break;
+        heap_trocar(f, i, maior);
+        i = maior;
+    }
+    return i;
+}
+
+static inline void heap_inserir(FilaPrioridade *f, const void *registro) {
+    memcpy(inventario_anexar(&f->registros), registro, f->registros.tamElem);
+    int pos = f->registros.tamanho - 1;
+    indice_inserir(&f->indice, pos);
+    heap_subir(f, pos);
+}
+
+// Retira o registro da posição 'pos' (copiado em 'saida', se não for NULL)
+static inline void heap_removerEm(FilaPrioridade *f, int pos, void *saida) {
+    int ultimo = f->registros.tamanho - 1;
+    if (saida != NULL) memcpy(saida, inventario_em(&f->registros, pos), f->registros.tamElem);
+    if (pos != ultimo) heap_trocar(f, pos, ultimo);
+    indice_remover(&f->indice, ultimo);
+    f->registros.tamanho--;
+    if (pos != ultimo && heap_subir(f, pos) == pos) heap_descer(f, pos);
+}
+
+// Retira o topo; devolve 0 se a fila está vazia
+static inline int heap_extrair(FilaPrioridade *f, void *saida) {
+    if (f->registros.tamanho == 0) return 0;
+    heap_removerEm(f, 0, saida);
+    return 1;
+}
+
+// Posição de um registro igual a 'registro' (byte a byte), ou -1.
+// O nome leva direto às entradas candidatas do índice.
+static inline int heap_localizar(const FilaPrioridade *f, const void *registro) {
+    const IndiceNome *idx = &f->indice;
+    const char *nome = (const char *)registro + idx->offsetChave;
+    uint32_t h = indice_hash(nome);
+    int mascara = idx->capacidade - 1;
+    for (int i = (int)(h & (uint32_t)mascara); idx->posicoes[i] != INDICE_VAZIO; i = (i + 1) & mascara) {
+        int p = idx->posicoes[i];
+        if (p >= 0 && idx->hashes[i] == h &&
+            memcmp(inventario_em(&f->registros, p), registro, f->registros.tamElem) == 0)
+            return p;
+    }
+    return -1;
+}
+
+// Troca o registro da posição 'pos' por 'novo' (outra prioridade, por
+// exemplo) e o leva ao lugar certo. Devolve a nova posição.
+static inline int heap_atualizar(FilaPrioridade *f, int pos, const void *novo) {
+    indice_remover(&f->indice, pos);
+    memcpy(inventario_em(&f->registros, pos), novo, f->registros.tamElem);
+    indice_inserir(&f->indice, pos);
+    int i = heap_subir(f, pos);
+    return i == pos ? heap_descer(f, pos) : i;
+}
+
+// Refaz a fila com os n registros de 'base': montagem de baixo para cima, O(n)
+static inline void heap_montar(FilaPrioridade *f, const void *base, int n) {
+    f->registros.tamanho = 0;
+    inventario_reservar(&f->registros, n);
+    if (n > 0) memcpy(f->registros.dados, base, (size_t)n * f->registros.tamElem);
+    f->registros.tamanho = n;
+    indice_reconstruir(&f->indice);
+    for (int i = (n - 2) / HEAP_ARIDADE; n > 1 && i >= 0; i--) heap_descer(f, i);
+}
+
+// -----------------------------
+// Os k primeiros de um vetor, sem ordenar o resto
+// -----------------------------
+
+// Heap de mínimo de índices: o pior dos escolhidos fica em sel[0]
+static inline void heap_descerPior(const char *base, size_t tamElem, ComparadorHeap cmp, int *sel, int m, int i,
+                                   long *comparacoes) {
+    for (;;) {
+        int filho = 2 * i + 1;
+        if (filho >= m) break;
+        if (filho + 1 < m) {
+            (*comparacoes)++;
+            if (cmp(base + (size_t)sel[filho + 1] * tamElem, base + (size_t)sel[filho] * tamElem) < 0) filho++;
+        }
+        (*comparacoes)++;
+        if (cmp(base + (size_t)sel[filho] * tamElem, base + (size_t)sel[i] * tamElem) >= 0) break;
+        int t = sel[i]; sel[i] = sel[filho]; sel[filho] = t;
+        i = filho;
+    }
+}
+
+// Índices dos k registros de base[0..n) que saem primeiro segundo cmp, do
+// primeiro ao k-ésimo, em sel[]. Cada registro custa uma comparação com o
+// pior escolhido e, se entrar, O(log k). Devolve quantos (min(k, n)).
+static inline int heap_selecionarK(const void *base, size_t tamElem, int n, int k, ComparadorHeap cmp, int *sel,
+                                   long *comparacoes) {
+    const char *b = (const char *)base;
+    int m = 0;
+    *comparacoes = 0;
+    if (k <= 0) return 0;
+    for (int i = 0; i < n; i++) {
+        if (m < k) {
+            // entra direto e sobe até o lugar (heap de mínimo)
+            int j = m++;
+            sel[j] = i;
+            while (j > 0) {
+                int pai = (j - 1) / 2;
+                (*comparacoes)++;
+                if (cmp(b + (size_t)sel[j] * tamElem, b + (size_t)sel[pai] * tamElem) >= 0) break;
+                int t = sel[j]; sel[j] = sel[pai]; sel[pai] = t;
+                j = pai;
+            }
+        } else {
+            (*comparacoes)++;
+            if (cmp(b + (size_t)i * tamElem, b + (size_t)sel[0] * tamElem) <= 0) continue;
+            sel[0] = i;
+            heap_descerPior(b, tamElem, cmp, sel, m, 0, comparacoes);
+        }
+    }
+    // retira o pior para o fim até sobrar um: sel fica do primeiro ao último
+    for (int fim = m - 1; fim > 0; fim--) {
+        int t = sel[0]; sel[0] = sel[fim]; sel[fim] = t;
+        heap_descerPior(b, tamElem, cmp, sel, fim, 0, comparacoes);
+    }
+    return m;
+}
+
+#endif
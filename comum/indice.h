@@ -0,0 +1,178 @@
+/* indice.h
+ *
+ * Índice hash por nome (endereçamento aberto, sondagem linear) sobre um
+ * Inventario. A tabela guarda só posições no inventário e o hash do nome;
+ * a chave é lida do próprio registro (offsetChave bytes a partir do início).
+ * Precisa ser mantido em sincronia com inserções, remoções e ordenações.
+ */
+
+#ifndef FREEFIRE_INDICE_H
+#define FREEFIRE_INDICE_H
+
+#include <stdint.h>
+
+#include "inventario.h"
+
+#define INDICE_VAZIO   -1
+#define INDICE_REMOVIDO -2  // lápide: mantém a cadeia de sondagem intacta
+#define INDICE_CAP_INICIAL 64
+
+typedef struct {
+    const Inventario *inv;
+    size_t offsetChave;
+    uint32_t *hashes;
+    int *posicoes;       // posição no inventário, VAZIO ou REMOVIDO
+    int capacidade;      // potência de 2
+    int ocupados;        // entradas válidas
+    int usados;          // válidas + lápides
+} IndiceNome;
+
+// FNV-1a 32 bits
+static inline uint32_t indice_hash(const char *s) {
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static inline const char *indice_chave(const IndiceNome *idx, int pos) {
+    return (const char *)inventario_em(idx->inv, pos) + idx->offsetChave;
+}
+
+static inline void indice_alocarTabela(IndiceNome *idx, int capacidade) {
+    idx->hashes = (uint32_t *)malloc((size_t)capacidade * sizeof(uint32_t));
+    idx->posicoes = (int *)malloc((size_t)capacidade * sizeof(int));
+    if (idx->hashes == NULL || idx->posicoes == NULL) {
+        fprintf(stderr, "Memória insuficiente (índice).\n");
+        exit(1);
+    }
+    for (int i = 0; i < capacidade; i++) idx->posicoes[i] = INDICE_VAZIO;
+    idx->capacidade = capacidade;
+    idx->ocupados = 0;
+    idx->usados = 0;
+}
+
+static inline void indice_iniciar(IndiceNome *idx, const Inventario *inv, size_t offsetChave) {
+    idx->inv = inv;
+    idx->offsetChave = offsetChave;
+    indice_alocarTabela(idx, INDICE_CAP_INICIAL);
+}
+
+static inline void indice_liberar(IndiceNome *idx) {
+    free(idx->hashes);
+    free(idx->posicoes);
+    idx->hashes = NULL;
+    idx->posicoes = NULL;
+    idx->capacidade = idx->ocupados = idx->usados = 0;
+}
+
+// Coloca (hash, pos) no primeiro espaço livre da cadeia; não verifica carga
+static inline void indice_colocar(IndiceNome *idx, uint32_t h, int pos) {
+    int mascara = idx->capacidade - 1;
+    int i = (int)(h & (uint32_t)mascara);
+    while (idx->posicoes[i] >= 0) i = (i + 1) & mascara;
+    if (idx->posicoes[i] == INDICE_VAZIO) idx->usados++;
+    idx->hashes[i] = h;
+    idx->posicoes[i] = pos;
+    idx->ocupados++;
+}
+
+// Refaz a tabela (descarta lápides); dobra se estiver mais da metade cheia
+static inline void indice_redimensionar(IndiceNome *idx) {
+    uint32_t *hashes = idx->hashes;
+    int *posicoes = idx->posicoes;
+    int capAntiga = idx->capacidade;
+    int novaCap = capAntiga;
+    while (idx->ocupados + 1 > novaCap / 2) novaCap *= 2;
+
+    indice_alocarTabela(idx, novaCap);
+    for (int i = 0; i < capAntiga; i++) {
+        if (posicoes[i] >= 0) indice_colocar(idx, hashes[i], posicoes[i]);
+    }
+    free(hashes);
+    free(posicoes);
+}
+
+// Registra o registro que está na posição 'pos' do inventário
+static inline void indice_inserir(IndiceNome *idx, int pos) {
+    if ((idx->usados + 1) * 10 > idx->capacidade * 7) indice_redimensionar(idx);
+    indice_colocar(idx, indice_hash(indice_chave(idx, pos)), pos);
+}
+
+// Procura a entrada de 'nome' e devolve o espaço da tabela (ou -1).
+// Se 'pos' >= 0, exige também que a entrada aponte para essa posição.
+// Cada espaço visitado conta como uma sondagem.
+static inline int indice_localizar(const IndiceNome *idx, const char *nome, int pos, int *sondagens) {
+    uint32_t h = indice_hash(nome);
+    int mascara = idx->capacidade - 1;
+    int i = (int)(h & (uint32_t)mascara);
+    int s = 0;
+    while (idx->posicoes[i] != INDICE_VAZIO) {
+        s++;
+        int p = idx->posicoes[i];
+        if (p >= 0 && idx->hashes[i] == h && (pos < 0 || p == pos) &&
+            strcmp(indice_chave(idx, p), nome) == 0) {
+            if (sondagens) *sondagens = s;
+            return i;
+        }
+        i = (i + 1) & mascara;
+    }
+    if (sondagens) *sondagens = s + 1; // o espaço vazio também foi examinado
+    return -1;
+}
+
+// Busca por nome: devolve a posição no inventário ou -1
+static inline int indice_buscar(const IndiceNome *idx, const char *nome, int *sondagens) {
+    int i = indice_localizar(idx, nome, -1, sondagens);
+    return i < 0 ? -1 : idx->posicoes[i];
+}
+
+// Retira a entrada do registro na posição 'pos' (chamar antes de sobrescrevê-lo)
+static inline void indice_remover(IndiceNome *idx, int pos) {
+    int i = indice_localizar(idx, indice_chave(idx, pos), pos, NULL);
+    if (i < 0) return;
+    idx->posicoes[i] = INDICE_REMOVIDO;
+    idx->ocupados--;
+}
+
+// O registro da posição 'de' foi (ou vai ser) movido para 'para'
+static inline void indice_mover(IndiceNome *idx, int de, int para) {
+    int i = indice_localizar(idx, indice_chave(idx, de), de, NULL);
+    if (i >= 0) idx->posicoes[i] = para;
+}
+
+// Soma 'delta' a toda posição >= aPartirDe, depois de um deslocamento em
+// bloco no inventário. Percorre a tabela uma vez, sem recalcular hashes.
+static inline void indice_deslocar(IndiceNome *idx, int aPartirDe, int delta) {
+    for (int i = 0; i < idx->capacidade; i++) {
+        if (idx->posicoes[i] >= aPartirDe) idx->posicoes[i] += delta;
+    }
+}
+
+// Remove a posição 'pos' em O(1): o último registro ocupa o lugar dela.
+// Não preserva a ordem do inventário.
+static inline void indice_removerTrocandoUltimo(IndiceNome *idx, Inventario *inv, int pos) {
+    int ultimo = inv->tamanho - 1;
+    indice_remover(idx, pos);
+    if (pos != ultimo) {
+        indice_mover(idx, ultimo, pos);
+        memcpy(inventario_em(inv, pos), inventario_em(inv, ultimo), inv->tamElem);
+    }
+    inv->tamanho--;
+}
+
+// Reconstrói todo o índice (após ordenações ou deslocamentos em bloco)
+static inline void indice_reconstruir(IndiceNome *idx) {
+    int cap = INDICE_CAP_INICIAL;
+    while ((idx->inv->tamanho + 1) * 10 > cap * 7) cap *= 2;
+    free(idx->hashes);
+    free(idx->posicoes);
+    indice_alocarTabela(idx, cap);
+    for (int p = 0; p < idx->inv->tamanho; p++) {
+        indice_colocar(idx, indice_hash(indice_chave(idx, p)), p);
+    }
+}
+
+#endif
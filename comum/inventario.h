@@ -0,0 +1,84 @@
+/* inventario.h
+ *
+ * Vetor crescente de registros de tamanho fixo (Item, Componente...),
+ * com memória tirada de uma Arena. Anexar é O(1) amortizado: a capacidade
+ * dobra quando enche, e o bloco antigo fica na arena até arena_liberar().
+ */
+
+#ifndef FREEFIRE_INVENTARIO_H
+#define FREEFIRE_INVENTARIO_H
+
+#include "arena.h"
+
+#define INVENTARIO_CAP_INICIAL 16
+
+typedef struct {
+    Arena *arena;
+    char *dados;
+    int tamanho;
+    int capacidade;
+    size_t tamElem;
+} Inventario;
+
+static inline void inventario_iniciar(Inventario *inv, Arena *arena, size_t tamElem) {
+    inv->arena = arena;
+    inv->dados = NULL;
+    inv->tamanho = 0;
+    inv->capacidade = 0;
+    inv->tamElem = tamElem;
+}
+
+// Garante espaço para pelo menos 'minimo' registros
+static inline void inventario_reservar(Inventario *inv, int minimo) {
+    if (minimo <= inv->capacidade) return;
+    int novaCap = inv->capacidade ? inv->capacidade : INVENTARIO_CAP_INICIAL;
+    while (novaCap < minimo) novaCap *= 2;
+    inv->dados = (char *)arena_realocar(inv->arena, inv->dados,
+                                        (size_t)inv->capacidade * inv->tamElem,
+                                        (size_t)novaCap * inv->tamElem);
+    inv->capacidade = novaCap;
+}
+
+// Passa a usar 'dados' (memória fora da arena, como um snapshot mapeado)
+// com n registros, sem copiar. O primeiro crescimento copia para a arena.
+static inline void inventario_adotar(Inventario *inv, void *dados, int n) {
+    inv->dados = (char *)dados;
+    inv->tamanho = n;
+    inv->capacidade = n;
+}
+
+static inline void *inventario_em(const Inventario *inv, int i) {
+    return inv->dados + (size_t)i * inv->tamElem;
+}
+
+// Abre uma posição zerada no fim e devolve o ponteiro para ela.
+// O ponteiro (e 'dados') pode mudar na próxima chamada.
+static inline void *inventario_anexar(Inventario *inv) {
+    inventario_reservar(inv, inv->tamanho + 1);
+    void *slot = inventario_em(inv, inv->tamanho);
+    memset(slot, 0, inv->tamElem);
+    inv->tamanho++;
+    return slot;
+}
+
+// Abre uma posição zerada em i deslocando os seguintes para a direita
+// (um único memmove). Mesma ressalva de inventario_anexar sobre 'dados'.
+static inline void *inventario_inserirEm(Inventario *inv, int i) {
+    inventario_reservar(inv, inv->tamanho + 1);
+    memmove(inventario_em(inv, i + 1), inventario_em(inv, i),
+            (size_t)(inv->tamanho - i) * inv->tamElem);
+    void *slot = inventario_em(inv, i);
+    memset(slot, 0, inv->tamElem);
+    inv->tamanho++;
+    return slot;
+}
+
+// Remove a posição i deslocando os seguintes para a esquerda
+static inline void inventario_remover(Inventario *inv, int i) {
+    if (i < 0 || i >= inv->tamanho) return;
+    memmove(inventario_em(inv, i), inventario_em(inv, i + 1),
+            (size_t)(inv->tamanho - i - 1) * inv->tamElem);
+    inv->tamanho--;
+}
+
+#endif
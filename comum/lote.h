@@ -0,0 +1,104 @@
+/* lote.h
+ *
+ * Modo lote (não interativo) compartilhado pelos três níveis.
+ * Lê um comando por linha de um arquivo ou de stdin (em blocos, via
+ * entrada.h), sem prompts, e deixa a saída totalmente bufferizada para que
+ * o terminal não limite a vazão.
+ *
+ * Uso:  ./FreeFire --lote [arquivo]     (sem arquivo: lê de stdin)
+ *       Outras opções "--..." podem vir depois (ex.: --snapshot no Mestre).
+ *
+ * Formato: tokens separados por espaço; linhas vazias ou iniciadas por '#'
+ * são ignoradas. Cada nível define seus próprios comandos (ver executarLote).
+ */
+
+#ifndef FREEFIRE_LOTE_H
+#define FREEFIRE_LOTE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "entrada.h"
+
+#define LOTE_BUFFER_SAIDA ((size_t)1 << 20)
+
+typedef struct {
+    LeitorEntrada leitor; // arquivo ou stdin, lido em blocos
+    char *cursor;
+    long numLinha;
+} Lote;
+
+// Verifica se o programa foi chamado com --lote
+static inline int lote_solicitado(int argc, char *argv[]) {
+    return argc > 1 && strcmp(argv[1], "--lote") == 0;
+}
+
+// Abre a entrada do lote e bufferiza stdout. Retorna 0 em caso de erro.
+static inline int lote_abrir(Lote *l, int argc, char *argv[]) {
+    FILE *entrada = stdin;
+    if (argc > 2 && strncmp(argv[2], "--", 2) != 0) {
+        entrada = fopen(argv[2], "r");
+        if (entrada == NULL) {
+            fprintf(stderr, "Não foi possível abrir '%s'.\n", argv[2]);
+            return 0;
+        }
+    }
+    setvbuf(stdout, NULL, _IOFBF, LOTE_BUFFER_SAIDA);
+    entrada_iniciar(&l->leitor, entrada);
+    l->cursor = l->leitor.buffer;
+    l->leitor.buffer[0] = '\0';
+    l->numLinha = 0;
+    return 1;
+}
+
+static inline void lote_fechar(Lote *l) {
+    if (l->leitor.arquivo != stdin) fclose(l->leitor.arquivo);
+    fflush(stdout);
+}
+
+// Próximo token da linha atual (NULL se acabou)
+static inline char *lote_token(Lote *l) {
+    return entrada_token(&l->cursor);
+}
+
+// Avança para a próxima linha com comando e devolve o comando (NULL no fim)
+static inline char *lote_proximoComando(Lote *l) {
+    char *linha;
+    while ((linha = entrada_linha(&l->leitor)) != NULL) {
+        l->numLinha = l->leitor.numLinha;
+        l->cursor = linha;
+        char *cmd = lote_token(l);
+        if (cmd != NULL && cmd[0] != '#') return cmd;
+    }
+    return NULL;
+}
+
+// Espera até 'ns' nanossegundos pelo próximo comando sem lê-lo. Devolve 0
+// se o prazo passou antes (ex.: para gravar o log enquanto a entrada está
+// parada), 1 se há o que ler ou a entrada acabou.
+static inline int lote_aguardarComando(Lote *l, long long ns) {
+    return entrada_aguardar(&l->leitor, ns);
+}
+
+// Copia o próximo token para 'out' (truncando em maxlen-1 e completando
+// com zeros). Retorna 0 se faltou.
+static inline int lote_texto(Lote *l, char *out, int maxlen) {
+    char *t = lote_token(l);
+    if (t == NULL) return 0;
+    entrada_copiarTexto(out, maxlen, t);
+    return 1;
+}
+
+// Lê o próximo token como inteiro. Retorna 0 se faltou ou não é número.
+static inline int lote_inteiro(Lote *l, int *out) {
+    char *t = lote_token(l);
+    return t != NULL && entrada_converterInteiro(t, out);
+}
+
+// Mensagem padrão para linhas mal formadas
+static inline void lote_erro(const Lote *l, const char *msg) {
+    printf("erro linha %ld: %s\n", l->numLinha, msg);
+}
+
+#endif
@@ -0,0 +1,380 @@
+/* ordenacao.h
+ *
+ * Motor de ordenação O(n log n) sobre um vetor de índices (permutação).
+ * Os registros não são movidos durante a ordenação: só os índices 'int'.
+ * Depois, ordenacao_aplicarPermutacao() reposiciona cada registro uma vez.
+ *
+ *   - Introsort: quicksort (mediana de três) que cai para heapsort quando a
+ *     recursão passa de 2*log2(n), e insertion sort em trechos pequenos.
+ *   - Merge sort: estável, de cima para baixo, com buffer auxiliar de índices.
+ *
+ * Para chaves inteiras há ainda os lineares (sem comparações): counting sort,
+ * para faixas pequenas como a prioridade, e radix sort LSD de 8 bits.
+ * Eles movem os registros diretamente e contam passagens e movimentações.
+ * As variantes *Coluna recebem só o vetor de chaves (layout colunar) e
+ * devolvem a permutação, sem tocar nos registros.
+ */
+
+#ifndef FREEFIRE_ORDENACAO_H
+#define FREEFIRE_ORDENACAO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ORDENACAO_CORTE_INSERCAO 16
+#define ORDENACAO_CONTAGEM_MAX_FAIXA (1 << 20) // acima disso use o radix
+
+// Compara dois registros: <0, 0 ou >0 (como strcmp)
+typedef int (*Comparador)(const void *a, const void *b);
+
+typedef struct {
+    const char *base;
+    size_t tamElem;
+    Comparador cmp;
+    long comparacoes;
+} ContextoOrdenacao;
+
+static inline int ordenacao_cmp(ContextoOrdenacao *c, int a, int b) {
+    c->comparacoes++;
+    return c->cmp(c->base + (size_t)a * c->tamElem, c->base + (size_t)b * c->tamElem);
+}
+
+static inline void *ordenacao_alocar(size_t bytes) {
+    void *p = malloc(bytes ? bytes : 1);
+    if (p == NULL) {
+        fprintf(stderr, "Memória insuficiente (ordenação).\n");
+        exit(1);
+    }
+    return p;
+}
+
+// Preenche perm com 0..n-1
+static inline void ordenacao_identidade(int *perm, int n) {
+    for (int i = 0; i < n; i++) perm[i] = i;
+}
+
+// -----------------------------
+// Insertion sort (estável) em perm[ini..fim)
+// -----------------------------
+static inline void ordenacao_insercao(ContextoOrdenacao *c, int *perm, int ini, int fim) {
+    for (int i = ini + 1; i < fim; i++) {
+        int chave = perm[i];
+        int j = i - 1;
+        while (j >= ini && ordenacao_cmp(c, perm[j], chave) > 0) {
+            perm[j + 1] = perm[j];
+            j--;
+        }
+        perm[j + 1] = chave;
+    }
+}
+
+// -----------------------------
+// Heapsort em perm[ini..fim) (fallback do introsort)
+// -----------------------------
+static inline void ordenacao_descer(ContextoOrdenacao *c, int *v, int i, int n) {
+    int x = v[i];
+    while (2 * i + 1 < n) {
+        int filho = 2 * i + 1;
+        if (filho + 1 < n && ordenacao_cmp(c, v[filho + 1], v[filho]) > 0) filho++;
+        if (ordenacao_cmp(c, v[filho], x) <= 0) break;
+        v[i] = v[filho];
+        i = filho;
+    }
+    v[i] = x;
+}
+
+static inline void ordenacao_heapsort(ContextoOrdenacao *c, int *perm, int ini, int fim) {
+    int *v = perm + ini;
+    int n = fim - ini;
+    for (int i = n / 2 - 1; i >= 0; i--) ordenacao_descer(c, v, i, n);
+    for (int i = n - 1; i > 0; i--) {
+        int t = v[0]; v[0] = v[i]; v[i] = t;
+        ordenacao_descer(c, v, 0, i);
+    }
+}
+
+// -----------------------------
+// Introsort
+// -----------------------------
+static inline void ordenacao_introRec(ContextoOrdenacao *c, int *perm, int ini, int fim, int profundidade) {
+    while (fim - ini > ORDENACAO_CORTE_INSERCAO) {
+        if (profundidade-- == 0) {
+            ordenacao_heapsort(c, perm, ini, fim);
+            return;
+        }
+
+        // mediana de três leva o pivô para perm[ini]
+        int meio = ini + (fim - ini) / 2;
+        int a = ini + 1, b = meio, d = fim - 1;
+        if (ordenacao_cmp(c, perm[a], perm[b]) > 0) { int t = a; a = b; b = t; }
+        if (ordenacao_cmp(c, perm[b], perm[d]) > 0) { b = d; if (ordenacao_cmp(c, perm[a], perm[b]) > 0) b = a; }
+        int t = perm[ini]; perm[ini] = perm[b]; perm[b] = t;
+
+        // partição de Hoare em torno do pivô
+        int pivo = perm[ini];
+        int i = ini, j = fim;
+        while (1) {
+            do { i++; } while (i < fim && ordenacao_cmp(c, perm[i], pivo) < 0);
+            do { j--; } while (ordenacao_cmp(c, perm[j], pivo) > 0);
+            if (i >= j) break;
+            t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+        }
+        perm[ini] = perm[j];
+        perm[j] = pivo;
+
+        // recursão no lado menor, laço no maior (pilha O(log n))
+        if (j - ini < fim - (j + 1)) {
+            ordenacao_introRec(c, perm, ini, j, profundidade);
+            ini = j + 1;
+        } else {
+            ordenacao_introRec(c, perm, j + 1, fim, profundidade);
+            fim = j;
+        }
+    }
+    ordenacao_insercao(c, perm, ini, fim);
+}
+
+// Ordena perm (índices de 'base') por cmp; devolve o número de comparações
+static inline long ordenacao_introsort(const void *base, size_t tamElem, int *perm, int n, Comparador cmp) {
+    ContextoOrdenacao c = { (const char *)base, tamElem, cmp, 0 };
+    int profundidade = 0;
+    for (int k = n; k > 1; k >>= 1) profundidade += 2;
+    ordenacao_introRec(&c, perm, 0, n, profundidade);
+    return c.comparacoes;
+}
+
+// -----------------------------
+// Merge sort estável
+// -----------------------------
+static inline void ordenacao_mergeRec(ContextoOrdenacao *c, int *perm, int *aux, int ini, int fim) {
+    if (fim - ini <= ORDENACAO_CORTE_INSERCAO) {
+        ordenacao_insercao(c, perm, ini, fim);
+        return;
+    }
+    int meio = ini + (fim - ini) / 2;
+    ordenacao_mergeRec(c, perm, aux, ini, meio);
+    ordenacao_mergeRec(c, perm, aux, meio, fim);
+
+    // metades já em ordem: nada a intercalar
+    if (ordenacao_cmp(c, perm[meio - 1], perm[meio]) <= 0) return;
+
+    memcpy(aux + ini, perm + ini, (size_t)(meio - ini) * sizeof(int));
+    int i = ini, j = meio, k = ini;
+    while (i < meio && j < fim) {
+        // '<=' mantém a ordem original dos iguais (estabilidade)
+        if (ordenacao_cmp(c, aux[i], perm[j]) <= 0) perm[k++] = aux[i++];
+        else perm[k++] = perm[j++];
+    }
+    while (i < meio) perm[k++] = aux[i++];
+}
+
+static inline long ordenacao_mergesort(const void *base, size_t tamElem, int *perm, int n, Comparador cmp) {
+    ContextoOrdenacao c = { (const char *)base, tamElem, cmp, 0 };
+    int *aux = (int *)ordenacao_alocar((size_t)n * sizeof(int));
+    ordenacao_mergeRec(&c, perm, aux, 0, n);
+    free(aux);
+    return c.comparacoes;
+}
+
+// -----------------------------
+// Reposiciona os registros: base[i] = base_original[perm[i]]
+// Cada registro é copiado uma única vez para o buffer e de volta.
+// -----------------------------
+static inline void ordenacao_aplicarPermutacao(void *base, size_t tamElem, const int *perm, int n) {
+    char *tmp = (char *)ordenacao_alocar((size_t)n * tamElem);
+    const char *b = (const char *)base;
+    for (int i = 0; i < n; i++) {
+        memcpy(tmp + (size_t)i * tamElem, b + (size_t)perm[i] * tamElem, tamElem);
+    }
+    memcpy(base, tmp, (size_t)n * tamElem);
+    free(tmp);
+}
+
+// -----------------------------
+// Ordenações lineares por chave inteira (estáveis)
+// -----------------------------
+
+// Extrai a chave inteira de um registro
+typedef int (*ChaveInt)(const void *registro);
+
+// Counting sort: uma passagem acha min/max, outra conta, outra distribui.
+// Devolve o número de movimentações de registros; *passes recebe as passagens.
+static inline long ordenacao_contagem(void *base, size_t tamElem, int n, ChaveInt chave, int *passes) {
+    char *b = (char *)base;
+    *passes = 0;
+    if (n < 2) return 0;
+
+    int min = chave(b), max = min;
+    for (int i = 1; i < n; i++) {
+        int k = chave(b + (size_t)i * tamElem);
+        if (k < min) min = k;
+        if (k > max) max = k;
+    }
+    (*passes)++;
+
+    long faixa = (long)max - (long)min + 1;
+    if (faixa > ORDENACAO_CONTAGEM_MAX_FAIXA) return -1; // faixa grande demais
+
+    int *cont = (int *)calloc((size_t)faixa + 1, sizeof(int));
+    char *tmp = (char *)ordenacao_alocar((size_t)n * tamElem);
+    if (cont == NULL) {
+        fprintf(stderr, "Memória insuficiente (ordenação).\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < n; i++) cont[chave(b + (size_t)i * tamElem) - min + 1]++;
+    (*passes)++;
+    for (long k = 1; k <= faixa; k++) cont[k] += cont[k - 1];
+
+    for (int i = 0; i < n; i++) {
+        const char *r = b + (size_t)i * tamElem;
+        memcpy(tmp + (size_t)cont[chave(r) - min]++ * tamElem, r, tamElem);
+    }
+    (*passes)++;
+    memcpy(base, tmp, (size_t)n * tamElem);
+
+    free(cont);
+    free(tmp);
+    return n;
+}
+
+// Radix sort LSD, dígitos de 8 bits sobre a chave de 32 bits (com sinal).
+// Dígitos em que todas as chaves coincidem são pulados.
+static inline long ordenacao_radix(void *base, size_t tamElem, int n, ChaveInt chave, int *passes) {
+    *passes = 0;
+    if (n < 2) return 0;
+
+    char *origem = (char *)base;
+    char *destino = (char *)ordenacao_alocar((size_t)n * tamElem);
+    char *buffer = destino;
+    long movimentos = 0;
+
+    // histogramas dos 4 dígitos numa única passagem
+    int hist[4][256];
+    memset(hist, 0, sizeof(hist));
+    for (int i = 0; i < n; i++) {
+        // inverter o bit de sinal põe os negativos antes dos positivos
+        unsigned int k = (unsigned int)chave(origem + (size_t)i * tamElem) ^ 0x80000000u;
+        for (int d = 0; d < 4; d++) hist[d][(k >> (8 * d)) & 0xFF]++;
+    }
+    (*passes)++;
+
+    for (int d = 0; d < 4; d++) {
+        unsigned int primeiro = ((unsigned int)chave(origem) ^ 0x80000000u) >> (8 * d) & 0xFF;
+        if (hist[d][primeiro] == n) continue; // dígito constante: nada a fazer
+
+        int pos[256];
+        int soma = 0;
+        for (int v = 0; v < 256; v++) { pos[v] = soma; soma += hist[d][v]; }
+
+        for (int i = 0; i < n; i++) {
+            const char *r = origem + (size_t)i * tamElem;
+            unsigned int k = (unsigned int)chave(r) ^ 0x80000000u;
+            memcpy(destino + (size_t)pos[(k >> (8 * d)) & 0xFF]++ * tamElem, r, tamElem);
+        }
+        movimentos += n;
+        (*passes)++;
+
+        char *t = origem; origem = destino; destino = t;
+    }
+
+    if (origem != (char *)base) {
+        memcpy(base, origem, (size_t)n * tamElem);
+        movimentos += n;
+    }
+    free(buffer);
+    return movimentos;
+}
+
+// -----------------------------
+// Ordenações lineares sobre uma coluna de chaves (layout colunar).
+// Leem apenas 'chaves' (4 bytes por registro) e preenchem perm com a ordem
+// estável; cada coluna é reposicionada depois com ordenacao_aplicarPermutacao.
+// Devolvem o número de índices movidos.
+// -----------------------------
+
+static inline long ordenacao_contagemColuna(const int *chaves, int n, int *perm, int *passes) {
+    *passes = 0;
+    ordenacao_identidade(perm, n);
+    if (n < 2) return 0;
+
+    int min = chaves[0], max = min;
+    for (int i = 1; i < n; i++) {
+        if (chaves[i] < min) min = chaves[i];
+        if (chaves[i] > max) max = chaves[i];
+    }
+    (*passes)++;
+
+    long faixa = (long)max - (long)min + 1;
+    if (faixa > ORDENACAO_CONTAGEM_MAX_FAIXA) return -1;
+
+    int *cont = (int *)calloc((size_t)faixa + 1, sizeof(int));
+    if (cont == NULL) {
+        fprintf(stderr, "Memória insuficiente (ordenação).\n");
+        exit(1);
+    }
+    for (int i = 0; i < n; i++) cont[chaves[i] - min + 1]++;
+    (*passes)++;
+    for (long k = 1; k <= faixa; k++) cont[k] += cont[k - 1];
+
+    for (int i = 0; i < n; i++) perm[cont[chaves[i] - min]++] = i;
+    (*passes)++;
+
+    free(cont);
+    return n;
+}
+
+// Radix LSD de 8 bits levando junto o par (chave, índice): cada passagem
+// lê e escreve 8 bytes por registro, qualquer que seja o tamanho dele.
+static inline long ordenacao_radixColuna(const int *chaves, int n, int *perm, int *passes) {
+    *passes = 0;
+    ordenacao_identidade(perm, n);
+    if (n < 2) return 0;
+
+    unsigned int *chOrigem = (unsigned int *)ordenacao_alocar((size_t)n * sizeof(unsigned int));
+    unsigned int *chDestino = (unsigned int *)ordenacao_alocar((size_t)n * sizeof(unsigned int));
+    int *idxDestino = (int *)ordenacao_alocar((size_t)n * sizeof(int));
+    unsigned int *bufChaves[2] = { chOrigem, chDestino };
+    int *idxOrigem = perm, *bufIdx = idxDestino;
+    long movimentos = 0;
+
+    int hist[4][256];
+    memset(hist, 0, sizeof(hist));
+    for (int i = 0; i < n; i++) {
+        unsigned int k = (unsigned int)chaves[i] ^ 0x80000000u;
+        chOrigem[i] = k;
+        for (int d = 0; d < 4; d++) hist[d][(k >> (8 * d)) & 0xFF]++;
+    }
+    (*passes)++;
+
+    for (int d = 0; d < 4; d++) {
+        if (hist[d][(chOrigem[0] >> (8 * d)) & 0xFF] == n) continue; // dígito constante
+
+        int pos[256];
+        int soma = 0;
+        for (int v = 0; v < 256; v++) { pos[v] = soma; soma += hist[d][v]; }
+
+        for (int i = 0; i < n; i++) {
+            int j = pos[(chOrigem[i] >> (8 * d)) & 0xFF]++;
+            chDestino[j] = chOrigem[i];
+            idxDestino[j] = idxOrigem[i];
+        }
+        movimentos += n;
+        (*passes)++;
+
+        unsigned int *tc = chOrigem; chOrigem = chDestino; chDestino = tc;
+        int *ti = idxOrigem; idxOrigem = idxDestino; idxDestino = ti;
+    }
+
+    if (idxOrigem != perm) {
+        memcpy(perm, idxOrigem, (size_t)n * sizeof(int));
+        movimentos += n;
+    }
+    free(bufChaves[0]);
+    free(bufChaves[1]);
+    free(bufIdx);
+    return movimentos;
+}
+
+#endif
@@ -0,0 +1,444 @@
+/* paralelo.h
+ *
+ * Pool fixo de threads (pthreads) e merge sort paralelo sobre um vetor de
+ * índices, no mesmo esquema de ordenacao.h: só os índices 'int' se movem
+ * durante a ordenação e cada registro é copiado uma vez no final.
+ *
+ * O pool cresce até o maior número de threads já pedido e os trabalhadores
+ * ficam dormindo entre um lote de tarefas e outro: nenhuma ordenação cria
+ * threads. paralelo_executar() distribui as tarefas entre os trabalhadores
+ * e a própria thread que chamou, e volta quando todas terminam.
+ *
+ * O merge sort paralelo divide o vetor em um trecho por thread, ordena os
+ * trechos ao mesmo tempo e intercala os pares em rodadas. Cada intercalação
+ * é repartida entre as threads da rodada pelo ponto de corte na saída (busca
+ * binária no "caminho" da intercalação), então a última rodada, a de um par
+ * só, também usa todas as threads. Os iguais ficam na ordem original, como
+ * no merge sort serial. Abaixo de PARALELO_MINIMO registros, ou com uma
+ * thread, ele é o próprio ordenacao_mergesort().
+ *
+ * paralelo_simultaneas() é para poucas tarefas longas e independentes (as
+ * comparações de algoritmos): cada uma ganha uma thread própria, presa a um
+ * núcleo (afinidade só no Linux, com _GNU_SOURCE definido antes dos
+ * includes), e todas começam juntas.
+ *
+ * Sem pthreads (fora de Unix) as tarefas rodam em sequência na thread que
+ * chamou; o resultado é o mesmo.
+ */
+
+#ifndef FREEFIRE_PARALELO_H
+#define FREEFIRE_PARALELO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ordenacao.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <unistd.h>
+#define PARALELO_TEM_THREADS 1
+#else
+#define PARALELO_TEM_THREADS 0
+#endif
+
+#if PARALELO_TEM_THREADS && defined(__linux__) && defined(_GNU_SOURCE)
+#include <sched.h>
+#define PARALELO_TEM_AFINIDADE 1
+#else
+#define PARALELO_TEM_AFINIDADE 0
+#endif
+
+#define PARALELO_MAX_THREADS 64
+#define PARALELO_MINIMO (1 << 14) // abaixo disso o custo de acordar as threads não compensa
+
+// Tarefa do pool: recebe o i-ésimo elemento do vetor de argumentos
+typedef void (*TarefaParalela)(void *arg);
+
+typedef struct {
+#if PARALELO_TEM_THREADS
+    pthread_t threads[PARALELO_MAX_THREADS];
+    pthread_mutex_t trava;
+    pthread_cond_t temTrabalho; // trabalhadores esperam um lote novo
+    pthread_cond_t terminou;    // quem chamou espera o lote acabar
+#endif
+    int iniciado;
+    int numTrabalhadores;
+    int encerrar;
+    unsigned long geracao;      // muda a cada lote: acorda os trabalhadores
+    // lote atual
+    TarefaParalela tarefa;
+    char *args;
+    size_t tamArg;
+    int numTarefas;
+    int proxima;                // próxima tarefa a ser pega
+    int pendentes;              // tarefas ainda não concluídas
+} PoolThreads;
+
+// Pool compartilhado pelo programa
+static PoolThreads paralelo_pool;
+
+// Núcleos disponíveis (no mínimo 1, no máximo PARALELO_MAX_THREADS)
+static inline int paralelo_threadsDisponiveis(void) {
+    long n = 1;
+#if PARALELO_TEM_THREADS && defined(_SC_NPROCESSORS_ONLN)
+    n = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (n < 1) n = 1;
+    if (n > PARALELO_MAX_THREADS) n = PARALELO_MAX_THREADS;
+    return (int)n;
+}
+
+// Pega e roda tarefas do lote atual até acabarem (trava já obtida)
+static inline void paralelo_consumir(PoolThreads *p) {
+    while (p->proxima < p->numTarefas) {
+        int i = p->proxima++;
+#if PARALELO_TEM_THREADS
+        pthread_mutex_unlock(&p->trava);
+#endif
+        p->tarefa(p->args + (size_t)i * p->tamArg);
+#if PARALELO_TEM_THREADS
+        pthread_mutex_lock(&p->trava);
+#endif
+        if (--p->pendentes == 0) {
+#if PARALELO_TEM_THREADS
+            pthread_cond_signal(&p->terminou);
+#endif
+        }
+    }
+}
+
+#if PARALELO_TEM_THREADS
+static inline void *paralelo_trabalhador(void *arg) {
+    PoolThreads *p = (PoolThreads *)arg;
+    unsigned long vista = 0;
+    pthread_mutex_lock(&p->trava);
+    for (;;) {
+        while (!p->encerrar && p->geracao == vista) pthread_cond_wait(&p->temTrabalho, &p->trava);
+        if (p->encerrar) break;
+        vista = p->geracao;
+        paralelo_consumir(p);
+    }
+    pthread_mutex_unlock(&p->trava);
+    return NULL;
+}
+#endif
+
+// Sincronização do pool (o pool estático começa zerado, sem trabalhadores)
+static inline void paralelo_iniciar(PoolThreads *p) {
+    if (p->iniciado) return;
+#if PARALELO_TEM_THREADS
+    pthread_mutex_init(&p->trava, NULL);
+    pthread_cond_init(&p->temTrabalho, NULL);
+    pthread_cond_init(&p->terminou, NULL);
+#endif
+    p->iniciado = 1;
+}
+
+// Garante trabalhadores para 'threads' tarefas simultâneas (contando quem chama)
+static inline void paralelo_garantir(PoolThreads *p, int threads) {
+    if (threads > PARALELO_MAX_THREADS) threads = PARALELO_MAX_THREADS;
+    paralelo_iniciar(p);
+#if PARALELO_TEM_THREADS
+    while (p->numTrabalhadores < threads - 1) {
+        if (pthread_create(&p->threads[p->numTrabalhadores], NULL, paralelo_trabalhador, p) != 0) {
+            fprintf(stderr, "Não foi possível criar thread (pool).\n");
+            exit(1);
+        }
+        p->numTrabalhadores++;
+    }
+#else
+    (void)threads;
+#endif
+}
+
+// Roda tarefa(args[i]) para i em 0..n-1 e espera todas terminarem.
+// 'args' é um vetor de n elementos de tamArg bytes, um por tarefa.
+static inline void paralelo_executar(PoolThreads *p, TarefaParalela tarefa, void *args, size_t tamArg, int n) {
+    if (n <= 0) return;
+    paralelo_iniciar(p);
+#if PARALELO_TEM_THREADS
+    pthread_mutex_lock(&p->trava);
+#endif
+    p->tarefa = tarefa;
+    p->args = (char *)args;
+    p->tamArg = tamArg;
+    p->numTarefas = n;
+    p->proxima = 0;
+    p->pendentes = n;
+    p->geracao++;
+#if PARALELO_TEM_THREADS
+    if (n > 1) pthread_cond_broadcast(&p->temTrabalho);
+#endif
+    paralelo_consumir(p);
+#if PARALELO_TEM_THREADS
+    while (p->pendentes > 0) pthread_cond_wait(&p->terminou, &p->trava);
+    pthread_mutex_unlock(&p->trava);
+#endif
+}
+
+// Acorda e junta os trabalhadores (o pool pode ser usado de novo depois)
+static inline void paralelo_encerrar(PoolThreads *p) {
+#if PARALELO_TEM_THREADS
+    if (!p->iniciado) return;
+    pthread_mutex_lock(&p->trava);
+    p->encerrar = 1;
+    pthread_cond_broadcast(&p->temTrabalho);
+    pthread_mutex_unlock(&p->trava);
+    for (int i = 0; i < p->numTrabalhadores; i++) pthread_join(p->threads[i], NULL);
+    pthread_mutex_destroy(&p->trava);
+    pthread_cond_destroy(&p->temTrabalho);
+    pthread_cond_destroy(&p->terminou);
+#endif
+    memset(p, 0, sizeof(*p));
+}
+
+// -----------------------------
+// Tarefas simultâneas em threads próprias, presas a núcleos
+// -----------------------------
+
+// Núcleo em que a thread está rodando agora (-1 se não dá para saber)
+static inline int paralelo_cpuAtual(void) {
+#if PARALELO_TEM_AFINIDADE
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+// Núcleos que o processo pode usar, em ordem (até 'max'); 0 se não dá para saber
+static inline int paralelo_cpusPermitidas(int *cpus, int max) {
+    int n = 0;
+#if PARALELO_TEM_AFINIDADE
+    cpu_set_t permitidas;
+    if (sched_getaffinity(0, sizeof(permitidas), &permitidas) != 0) return 0;
+    for (int c = 0; c < CPU_SETSIZE && n < max; c++)
+        if (CPU_ISSET(c, &permitidas)) cpus[n++] = c;
+#else
+    (void)cpus;
+    (void)max;
+#endif
+    return n;
+}
+
+#if PARALELO_TEM_THREADS
+typedef struct {
+    TarefaParalela tarefa;
+    void *arg;
+} PartidaSimultanea;
+
+static inline void *paralelo_rodarSimultanea(void *arg) {
+    PartidaSimultanea *s = (PartidaSimultanea *)arg;
+    s->tarefa(s->arg);
+    return NULL;
+}
+#endif
+
+// Roda tarefa(args[i]) para i em 0..n-1, cada uma numa thread criada para
+// ela e presa ao i-ésimo núcleo permitido (em rodízio), e espera todas.
+// Se uma thread não puder ser criada, a tarefa roda na thread que chamou.
+static inline void paralelo_simultaneas(TarefaParalela tarefa, void *args, size_t tamArg, int n) {
+    char *a = (char *)args;
+#if PARALELO_TEM_THREADS
+    for (int ini = 0; ini < n; ini += PARALELO_MAX_THREADS) {
+        int k = n - ini < PARALELO_MAX_THREADS ? n - ini : PARALELO_MAX_THREADS;
+        pthread_t threads[PARALELO_MAX_THREADS];
+        PartidaSimultanea partidas[PARALELO_MAX_THREADS];
+        int criada[PARALELO_MAX_THREADS];
+        int cpus[PARALELO_MAX_THREADS];
+        int numCpus = paralelo_cpusPermitidas(cpus, PARALELO_MAX_THREADS);
+
+        for (int i = 0; i < k; i++) {
+            pthread_attr_t atributos;
+            pthread_attr_init(&atributos);
+#if PARALELO_TEM_AFINIDADE
+            if (numCpus > 0) {
+                cpu_set_t nucleo;
+                CPU_ZERO(&nucleo);
+                CPU_SET(cpus[(ini + i) % numCpus], &nucleo);
+                pthread_attr_setaffinity_np(&atributos, sizeof(nucleo), &nucleo);
+            }
+#else
+            (void)numCpus;
+#endif
+            partidas[i].tarefa = tarefa;
+            partidas[i].arg = a + (size_t)(ini + i) * tamArg;
+            criada[i] = pthread_create(&threads[i], &atributos, paralelo_rodarSimultanea, &partidas[i]) == 0;
+            pthread_attr_destroy(&atributos);
+        }
+        for (int i = 0; i < k; i++) {
+            if (criada[i]) pthread_join(threads[i], NULL);
+            else tarefa(partidas[i].arg);
+        }
+    }
+#else
+    for (int i = 0; i < n; i++) tarefa(a + (size_t)i * tamArg);
+#endif
+}
+
+// -----------------------------
+// Merge sort paralelo
+// -----------------------------
+
+// Uma tarefa: ordenar perm[ini..fim) ou intercalar um pedaço de um par de trechos
+typedef struct {
+    ContextoOrdenacao ctx;     // comparações contadas por tarefa
+    int *perm;
+    int *aux;
+    const int *origem;         // intercalação: trechos [ini, meio) e [meio, fim) de origem
+    int *destino;              // ... escritos nas mesmas posições de destino
+    int ini, meio, fim;
+    int saidaIni, saidaFim;    // pedaço da saída do par (0 .. fim-ini) desta tarefa
+} TrechoParalelo;
+
+static inline void paralelo_ordenarTrecho(void *arg) {
+    TrechoParalelo *t = (TrechoParalelo *)arg;
+    ordenacao_mergeRec(&t->ctx, t->perm, t->aux, t->ini, t->fim);
+}
+
+// Quantos dos k primeiros da intercalação de a[0..na) e b[0..nb) vêm de 'a'.
+// Nos iguais 'a' vai antes, como no merge serial.
+static inline int paralelo_corte(ContextoOrdenacao *c, const int *a, int na, const int *b, int nb, int k) {
+    int lo = k > nb ? k - nb : 0;
+    int hi = k < na ? k : na;
+    while (lo < hi) {
+        int i = lo + (hi - lo) / 2;
+        // b[k-i-1] não é menor que a[i]: a[i] sai antes, o corte está mais à frente
+        if (ordenacao_cmp(c, b[k - i - 1], a[i]) >= 0) lo = i + 1;
+        else hi = i;
+    }
+    return lo;
+}
+
+static inline void paralelo_intercalarPedaco(void *arg) {
+    TrechoParalelo *t = (TrechoParalelo *)arg;
+    const int *a = t->origem + t->ini;
+    const int *b = t->origem + t->meio;
+    int na = t->meio - t->ini, nb = t->fim - t->meio;
+    int i = paralelo_corte(&t->ctx, a, na, b, nb, t->saidaIni);
+    int j = t->saidaIni - i;
+    int iFim = paralelo_corte(&t->ctx, a, na, b, nb, t->saidaFim);
+    int jFim = t->saidaFim - iFim;
+    int *d = t->destino + t->ini + t->saidaIni;
+    while (i < iFim && j < jFim) {
+        if (ordenacao_cmp(&t->ctx, a[i], b[j]) <= 0) *d++ = a[i++];
+        else *d++ = b[j++];
+    }
+    while (i < iFim) *d++ = a[i++];
+    while (j < jFim) *d++ = b[j++];
+}
+
+// Ordena perm (índices de 'base') por cmp com até 'threads' threads do pool.
+// Devolve o número de comparações (somadas entre as threads).
+static inline long paralelo_mergesort(PoolThreads *p, const void *base, size_t tamElem, int *perm, int n,
+                                      Comparador cmp, int threads) {
+    if (threads > PARALELO_MAX_THREADS) threads = PARALELO_MAX_THREADS;
+    if (threads > n / ORDENACAO_CORTE_INSERCAO) threads = n / ORDENACAO_CORTE_INSERCAO;
+    if (threads <= 1 || n < PARALELO_MINIMO) return ordenacao_mergesort(base, tamElem, perm, n, cmp);
+    paralelo_garantir(p, threads);
+
+    int *aux = (int *)ordenacao_alocar((size_t)n * sizeof(int));
+    // uma tarefa por thread em cada fase; limites[] guarda os trechos ordenados
+    TrechoParalelo *tarefas = (TrechoParalelo *)ordenacao_alocar((size_t)threads * 2 * sizeof(TrechoParalelo));
+    int limites[PARALELO_MAX_THREADS + 1];
+    int numTrechos = threads;
+    long comparacoes = 0;
+
+    memset(tarefas, 0, (size_t)threads * sizeof(TrechoParalelo));
+    for (int k = 0; k <= numTrechos; k++) limites[k] = (int)((long long)n * k / numTrechos);
+    for (int k = 0; k < numTrechos; k++) {
+        TrechoParalelo *t = &tarefas[k];
+        t->ctx = (ContextoOrdenacao){ (const char *)base, tamElem, cmp, 0 };
+        t->perm = perm;
+        t->aux = aux;
+        t->ini = limites[k];
+        t->fim = limites[k + 1];
+    }
+    paralelo_executar(p, paralelo_ordenarTrecho, tarefas, sizeof(TrechoParalelo), numTrechos);
+    for (int k = 0; k < numTrechos; k++) comparacoes += tarefas[k].ctx.comparacoes;
+
+    // rodadas de intercalação, alternando entre perm e aux
+    int *origem = perm, *destino = aux;
+    while (numTrechos > 1) {
+        int pares = numTrechos / 2;
+        int pedacos = threads / pares; // pedaços por par: todas as threads ocupadas
+        int numTarefas = 0;
+        for (int q = 0; q < pares; q++) {
+            int ini = limites[2 * q], meio = limites[2 * q + 1], fim = limites[2 * q + 2];
+            for (int s = 0; s < pedacos; s++) {
+                TrechoParalelo *t = &tarefas[numTarefas++];
+                t->ctx = (ContextoOrdenacao){ (const char *)base, tamElem, cmp, 0 };
+                t->origem = origem;
+                t->destino = destino;
+                t->ini = ini;
+                t->meio = meio;
+                t->fim = fim;
+                t->saidaIni = (int)((long long)(fim - ini) * s / pedacos);
+                t->saidaFim = (int)((long long)(fim - ini) * (s + 1) / pedacos);
+            }
+        }
+        if (numTrechos % 2 == 1) {
+            // trecho sem par: intercalado com um trecho vazio (só copiado)
+            TrechoParalelo *t = &tarefas[numTarefas++];
+            t->ctx = (ContextoOrdenacao){ (const char *)base, tamElem, cmp, 0 };
+            t->origem = origem;
+            t->destino = destino;
+            t->ini = limites[numTrechos - 1];
+            t->meio = t->fim = limites[numTrechos];
+            t->saidaIni = 0;
+            t->saidaFim = t->fim - t->ini;
+        }
+        paralelo_executar(p, paralelo_intercalarPedaco, tarefas, sizeof(TrechoParalelo), numTarefas);
+        for (int k = 0; k < numTarefas; k++) comparacoes += tarefas[k].ctx.comparacoes;
+
+        // os limites dos pares somem; o trecho sem par continua
+        int novos = 0;
+        for (int k = 0; k < numTrechos; k += 2) limites[novos++] = limites[k];
+        limites[novos] = n;
+        numTrechos = novos;
+        int *tmp = origem; origem = destino; destino = tmp;
+    }
+    if (origem != perm) memcpy(perm, origem, (size_t)n * sizeof(int));
+
+    free(tarefas);
+    free(aux);
+    return comparacoes;
+}
+
+// Reposicionamento em paralelo: cada thread copia um pedaço da saída
+typedef struct {
+    const char *base;
+    char *destino;
+    size_t tamElem;
+    const int *perm;
+    int ini, fim;
+} PedacoPermutacao;
+
+static inline void paralelo_copiarPedaco(void *arg) {
+    PedacoPermutacao *t = (PedacoPermutacao *)arg;
+    for (int i = t->ini; i < t->fim; i++)
+        memcpy(t->destino + (size_t)i * t->tamElem, t->base + (size_t)t->perm[i] * t->tamElem, t->tamElem);
+}
+
+// Como ordenacao_aplicarPermutacao, dividido entre 'threads' threads
+static inline void paralelo_aplicarPermutacao(PoolThreads *p, void *base, size_t tamElem, const int *perm, int n,
+                                              int threads) {
+    if (threads > PARALELO_MAX_THREADS) threads = PARALELO_MAX_THREADS;
+    if (threads <= 1 || n < PARALELO_MINIMO) {
+        ordenacao_aplicarPermutacao(base, tamElem, perm, n);
+        return;
+    }
+    paralelo_garantir(p, threads);
+    char *tmp = (char *)ordenacao_alocar((size_t)n * tamElem);
+    PedacoPermutacao pedacos[PARALELO_MAX_THREADS];
+    for (int k = 0; k < threads; k++) {
+        pedacos[k] = (PedacoPermutacao){ (const char *)base, tmp, tamElem, perm,
+                                         (int)((long long)n * k / threads), (int)((long long)n * (k + 1) / threads) };
+    }
+    paralelo_executar(p, paralelo_copiarPedaco, pedacos, sizeof(PedacoPermutacao), threads);
+    memcpy(base, tmp, (size_t)n * tamElem);
+    free(tmp);
+}
+
+#endif
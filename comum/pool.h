@@ -0,0 +1,66 @@
+/* pool.h
+ *
+ * Pool de nós de tamanho fixo apoiado em arena, para listas encadeadas.
+ * Os nós são cortados em sequência de lotes contíguos (POOL_NOS_POR_LOTE
+ * por vez), então nós vizinhos na lista tendem a ser vizinhos na memória.
+ * Nós devolvidos entram numa lista livre e são reaproveitados primeiro.
+ * pool_liberar() descarta todos os nós de uma vez, sem percorrer a lista.
+ */
+
+#ifndef FREEFIRE_POOL_H
+#define FREEFIRE_POOL_H
+
+#include "arena.h"
+
+#define POOL_NOS_POR_LOTE 256
+
+typedef struct {
+    Arena arena;
+    size_t tamNo;
+    char *proximo;  // próximo nó nunca usado do lote atual
+    char *fim;      // fim do lote atual
+    void *livres;   // nós devolvidos (encadeados pelo primeiro ponteiro)
+    int emUso;
+} PoolNos;
+
+static inline void pool_iniciar(PoolNos *p, size_t tamNo) {
+    arena_iniciar(&p->arena);
+    // o nó livre guarda um ponteiro no início: tamanho e alinhamento mínimos
+    if (tamNo < sizeof(void *)) tamNo = sizeof(void *);
+    p->tamNo = (tamNo + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    p->proximo = p->fim = NULL;
+    p->livres = NULL;
+    p->emUso = 0;
+}
+
+// Devolve um nó (conteúdo indefinido)
+static inline void *pool_alocar(PoolNos *p) {
+    void *no;
+    if (p->livres != NULL) {
+        no = p->livres;
+        p->livres = *(void **)no;
+    } else {
+        if (p->proximo == p->fim) {
+            p->proximo = (char *)arena_alocar(&p->arena, p->tamNo * POOL_NOS_POR_LOTE);
+            p->fim = p->proximo + p->tamNo * POOL_NOS_POR_LOTE;
+        }
+        no = p->proximo;
+        p->proximo += p->tamNo;
+    }
+    p->emUso++;
+    return no;
+}
+
+static inline void pool_devolver(PoolNos *p, void *no) {
+    *(void **)no = p->livres;
+    p->livres = no;
+    p->emUso--;
+}
+
+// Libera todos os nós; o pool volta ao estado inicial
+static inline void pool_liberar(PoolNos *p) {
+    arena_liberar(&p->arena);
+    pool_iniciar(p, p->tamNo);
+}
+
+#endif
@@ -0,0 +1,238 @@
+/* snapshot.h
+ *
+ * Snapshot binário de um vetor de registros de tamanho fixo (Item,
+ * Componente...). O arquivo é um cabeçalho de 64 bytes seguido dos
+ * registros exatamente como estão na memória, então carregar é mapear o
+ * arquivo (mmap, cópia privada) e apontar para os registros: nada é lido
+ * campo a campo. O layout é o da máquina que gravou (mesma arquitetura).
+ *
+ * Cabeçalho: mágica, tipo do registro, versão, tamanho do registro,
+ * quantidade, checksum dos registros, flags do programa, a sequência da
+ * última operação do log (wal.h) já contida no snapshot e o tamanho do
+ * anexo: bytes livres do programa gravados depois dos registros (ex.: o
+ * dicionário de textos que os registros referenciam por id).
+ * A gravação usa um arquivo temporário + rename: o snapshot antigo só é
+ * substituído quando o novo está completo.
+ */
+
+#ifndef FREEFIRE_SNAPSHOT_H
+#define FREEFIRE_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SNAPSHOT_TEM_MMAP 1
+#else
+#define SNAPSHOT_TEM_MMAP 0
+#endif
+
+#define SNAPSHOT_MAGICA "FFSNAP\r\n" // \r\n denuncia conversão de fim de linha
+#define SNAPSHOT_VERSAO 2
+
+// Flags livres para o programa (ex.: vetor já ordenado por nome)
+#define SNAPSHOT_ORDENADO_NOME 1u
+
+typedef struct {
+    char magica[8];
+    char tipo[8];          // "ITEM", "COMPON"...: evita carregar o vetor errado
+    uint32_t versao;
+    uint32_t tamRegistro;
+    uint64_t quantidade;
+    uint64_t checksum;
+    uint64_t sequencia;    // última operação do log incluída (0: sem log)
+    uint32_t flags;
+    uint32_t tamAnexo;     // 0 em snapshots sem anexo
+    uint8_t reservado[8];  // completa 64 bytes: registros alinhados
+} CabecalhoSnapshot;
+
+typedef char snapshot_cabecalho_64_bytes[sizeof(CabecalhoSnapshot) == 64 ? 1 : -1];
+
+// Snapshot carregado: a região fica mapeada até snapshot_liberar()
+typedef struct {
+    void *mapa;
+    size_t tamMapa;
+    void *registros;
+    int quantidade;
+    uint32_t flags;
+    uint64_t sequencia;
+    void *anexo;       // logo depois dos registros (NULL se não há)
+    size_t tamAnexo;
+} Snapshot;
+
+static inline void snapshot_iniciar(Snapshot *s) {
+    memset(s, 0, sizeof(*s));
+}
+
+// Checksum de 64 bits em quatro faixas independentes de 8 bytes (as
+// multiplicações de uma faixa não esperam pelas outras)
+static inline uint64_t snapshot_checksum(const void *dados, size_t tam) {
+    const unsigned char *p = (const unsigned char *)dados;
+    const uint64_t K = 0x9E3779B97F4A7C15ULL;
+    uint64_t h[4] = { 1, 2, 3, 4 };
+    size_t i = 0;
+    for (; i + 32 <= tam; i += 32) {
+        for (int f = 0; f < 4; f++) {
+            uint64_t w;
+            memcpy(&w, p + i + 8 * f, 8);
+            h[f] = (h[f] ^ w) * K;
+            h[f] ^= h[f] >> 29;
+        }
+    }
+    uint64_t r = tam;
+    for (int f = 0; f < 4; f++) r = (r ^ h[f]) * K;
+    for (; i < tam; i++) r = (r ^ p[i]) * 0x100000001B3ULL;
+    return r ^ (r >> 32);
+}
+
+// Checksum de registros + anexo (sem anexo, é o dos registros)
+static inline uint64_t snapshot_checksumTotal(const void *registros, size_t tamRegistros,
+                                              const void *anexo, size_t tamAnexo) {
+    uint64_t h = snapshot_checksum(registros, tamRegistros);
+    if (tamAnexo > 0) h ^= snapshot_checksum(anexo, tamAnexo) * 0x9E3779B97F4A7C15ULL;
+    return h;
+}
+
+// Grava 'n' registros de 'tamRegistro' bytes seguidos do anexo e só
+// renomeia depois de o conteúdo estar no disco (fsync). Retorna 1 se gravou.
+static inline int snapshot_gravarComAnexo(const char *caminho, const char *tipo, const void *registros,
+                                          size_t tamRegistro, int n, uint32_t flags, uint64_t sequencia,
+                                          const void *anexo, size_t tamAnexo) {
+    CabecalhoSnapshot c;
+    memset(&c, 0, sizeof(c));
+    memcpy(c.magica, SNAPSHOT_MAGICA, 8);
+    strncpy(c.tipo, tipo, sizeof(c.tipo) - 1);
+    c.versao = SNAPSHOT_VERSAO;
+    c.tamRegistro = (uint32_t)tamRegistro;
+    c.quantidade = (uint64_t)n;
+    c.flags = flags;
+    c.sequencia = sequencia;
+    c.tamAnexo = (uint32_t)tamAnexo;
+    c.checksum = snapshot_checksumTotal(registros, (size_t)n * tamRegistro, anexo, tamAnexo);
+
+    size_t len = strlen(caminho);
+    char *temporario = (char *)malloc(len + 5);
+    if (temporario == NULL) return 0;
+    memcpy(temporario, caminho, len);
+    memcpy(temporario + len, ".tmp", 5);
+
+    FILE *f = fopen(temporario, "wb");
+    int ok = f != NULL;
+    if (ok) ok = fwrite(&c, sizeof(c), 1, f) == 1;
+    if (ok && n > 0) ok = fwrite(registros, tamRegistro, (size_t)n, f) == (size_t)n;
+    if (ok && tamAnexo > 0) ok = fwrite(anexo, tamAnexo, 1, f) == 1;
+#if SNAPSHOT_TEM_MMAP
+    if (ok) ok = fflush(f) == 0 && fsync(fileno(f)) == 0;
+#endif
+    if (f != NULL && fclose(f) != 0) ok = 0;
+    if (ok) ok = rename(temporario, caminho) == 0;
+    if (!ok) {
+        fprintf(stderr, "Não foi possível gravar o snapshot '%s'.\n", caminho);
+        remove(temporario);
+    }
+    free(temporario);
+    return ok;
+}
+
+static inline int snapshot_gravar(const char *caminho, const char *tipo, const void *registros,
+                                  size_t tamRegistro, int n, uint32_t flags, uint64_t sequencia) {
+    return snapshot_gravarComAnexo(caminho, tipo, registros, tamRegistro, n, flags, sequencia, NULL, 0);
+}
+
+static inline void snapshot_liberar(Snapshot *s) {
+    if (s->mapa != NULL) {
+#if SNAPSHOT_TEM_MMAP
+        munmap(s->mapa, s->tamMapa);
+#else
+        free(s->mapa);
+#endif
+    }
+    snapshot_iniciar(s);
+}
+
+// Carrega o arquivo inteiro (mmap privado: alterações ficam só na memória)
+static inline void *snapshot_abrirRegiao(const char *caminho, size_t *tam) {
+#if SNAPSHOT_TEM_MMAP
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    void *m = NULL;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        *tam = (size_t)st.st_size;
+        m = mmap(NULL, *tam, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (m == MAP_FAILED) m = NULL;
+    }
+    close(fd);
+    return m;
+#else
+    FILE *f = fopen(caminho, "rb");
+    if (f == NULL) return NULL;
+    void *m = NULL;
+    if (fseek(f, 0, SEEK_END) == 0) {
+        long t = ftell(f);
+        rewind(f);
+        if (t > 0 && (m = malloc((size_t)t)) != NULL && fread(m, 1, (size_t)t, f) != (size_t)t) {
+            free(m);
+            m = NULL;
+        }
+        *tam = (size_t)t;
+    }
+    fclose(f);
+    return m;
+#endif
+}
+
+// Mapeia e valida um snapshot. Retorna 1 e preenche 's' se estiver íntegro;
+// senão explica o motivo em stderr e retorna 0.
+static inline int snapshot_carregar(Snapshot *s, const char *caminho, const char *tipo, size_t tamRegistro) {
+    snapshot_iniciar(s);
+    size_t tam = 0;
+    void *m = snapshot_abrirRegiao(caminho, &tam);
+    if (m == NULL) {
+        fprintf(stderr, "Não foi possível abrir o snapshot '%s'.\n", caminho);
+        return 0;
+    }
+    s->mapa = m;
+    s->tamMapa = tam;
+
+    const CabecalhoSnapshot *c = (const CabecalhoSnapshot *)m;
+    const char *erro = NULL;
+    if (tam < sizeof(*c) || memcmp(c->magica, SNAPSHOT_MAGICA, 8) != 0) erro = "não é um snapshot";
+    else if (c->versao != SNAPSHOT_VERSAO) erro = "versão desconhecida";
+    else if (strncmp(c->tipo, tipo, sizeof(c->tipo)) != 0 || c->tamRegistro != tamRegistro)
+        erro = "tipo de registro diferente";
+    else if (c->quantidade > 0x7FFFFFFF || tam != sizeof(*c) + c->quantidade * tamRegistro + c->tamAnexo)
+        erro = "tamanho não confere (arquivo truncado?)";
+    else if (snapshot_checksumTotal((const char *)m + sizeof(*c), c->quantidade * tamRegistro,
+                                    (const char *)m + (tam - c->tamAnexo), c->tamAnexo) != c->checksum)
+        erro = "checksum não confere";
+
+    if (erro != NULL) {
+        fprintf(stderr, "Snapshot '%s' inválido: %s.\n", caminho, erro);
+        snapshot_liberar(s);
+        return 0;
+    }
+    s->registros = (char *)m + sizeof(*c);
+    s->quantidade = (int)c->quantidade;
+    s->flags = c->flags;
+    s->sequencia = c->sequencia;
+    s->tamAnexo = c->tamAnexo;
+    if (s->tamAnexo > 0) s->anexo = (char *)m + (tam - s->tamAnexo);
+    return 1;
+}
+
+// Valor de --snapshot <arquivo> na linha de comando (NULL se ausente)
+static inline const char *snapshot_argumento(int argc, char *argv[]) {
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--snapshot") == 0) return argv[i + 1];
+    }
+    return NULL;
+}
+
+#endif
@@ -0,0 +1,113 @@
+/* tabela.h
+ *
+ * Saída de listagens sem printf por linha: as linhas são montadas num
+ * buffer fixo (sem malloc), com inteiros formatados à mão, e vão ao
+ * terminal num único write quando a listagem termina (ou quando o buffer
+ * enche, em listagens muito grandes).
+ *
+ * O alinhamento segue o de printf("%-Ns"): conta bytes, não colunas.
+ * saida_descarregar() esvazia o stdio antes, para a ordem com os printf
+ * anteriores ser mantida.
+ *
+ * Listagens limitadas: as funções dos níveis recebem um limite de linhas
+ * (0 = todas), mostram as primeiras e terminam com saida_restantes()
+ * quando sobram linhas não exibidas.
+ */
+
+#ifndef FREEFIRE_TABELA_H
+#define FREEFIRE_TABELA_H
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define SAIDA_TEM_WRITE 1
+#else
+#define SAIDA_TEM_WRITE 0
+#endif
+
+#define SAIDA_CAPACIDADE (64 * 1024)
+#define SAIDA_MAIOR_LINHA 256 // cada linha cabe nisso (campos vêm de vetores fixos)
+
+typedef struct {
+    size_t usado;
+    char dados[SAIDA_CAPACIDADE];
+} BufferSaida;
+
+// Buffer compartilhado pelas listagens do programa
+static BufferSaida saida_tabela;
+
+static inline void saida_descarregar(BufferSaida *s) {
+    if (s->usado == 0) return;
+    fflush(stdout);
+#if SAIDA_TEM_WRITE
+    const char *p = s->dados;
+    size_t falta = s->usado;
+    while (falta > 0) {
+        ssize_t n = write(STDOUT_FILENO, p, falta);
+        if (n <= 0) break; // terminal fechado: não há a quem avisar
+        p += n;
+        falta -= (size_t)n;
+    }
+#else
+    fwrite(s->dados, 1, s->usado, stdout);
+    fflush(stdout);
+#endif
+    s->usado = 0;
+}
+
+// Chamada antes de cada linha: garante espaço para a maior linha
+static inline void saida_linha(BufferSaida *s) {
+    if (s->usado + SAIDA_MAIOR_LINHA > SAIDA_CAPACIDADE) saida_descarregar(s);
+}
+
+static inline void saida_caractere(BufferSaida *s, char c) {
+    s->dados[s->usado++] = c;
+}
+
+static inline void saida_texto(BufferSaida *s, const char *t) {
+    size_t n = strlen(t);
+    memcpy(s->dados + s->usado, t, n);
+    s->usado += n;
+}
+
+// Texto alinhado à esquerda em 'largura' bytes (como "%-Ns")
+static inline void saida_coluna(BufferSaida *s, const char *t, int largura) {
+    size_t n = strlen(t);
+    memcpy(s->dados + s->usado, t, n);
+    s->usado += n;
+    for (int i = (int)n; i < largura; i++) s->dados[s->usado++] = ' ';
+}
+
+// Inteiro em decimal alinhado à esquerda (como "%-Nd"; largura 0: sem preenchimento)
+static inline void saida_inteiro(BufferSaida *s, long long v, int largura) {
+    char tmp[24];
+    int n = 0;
+    unsigned long long u = v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+    do {
+        tmp[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (v < 0) tmp[n++] = '-';
+    int escritos = n;
+    while (n > 0) s->dados[s->usado++] = tmp[--n];
+    for (; escritos < largura; escritos++) s->dados[s->usado++] = ' ';
+}
+
+// Rodapé de listagem cortada: quantas linhas ficaram de fora
+static inline void saida_restantes(BufferSaida *s, int restantes, const char *comoVerTudo) {
+    if (restantes <= 0) return;
+    saida_linha(s);
+    saida_texto(s, "... mais ");
+    saida_inteiro(s, restantes, 0);
+    saida_texto(s, " não exibidos");
+    if (comoVerTudo != NULL) {
+        saida_texto(s, " (");
+        saida_texto(s, comoVerTudo);
+        saida_caractere(s, ')');
+    }
+    saida_caractere(s, '\n');
+}
+
+#endif
@@ -0,0 +1,269 @@
+/* versoes.h
+ *
+ * Vetor ordenado de registros de tamanho fixo para muitas leituras
+ * simultâneas e poucas escritas, sem trava do lado de quem lê.
+ *
+ * Quem escreve nunca mexe na versão publicada: copia o vetor com a
+ * inserção ou remoção já feita e publica a cópia trocando um ponteiro
+ * atômico. Quem lê pega o ponteiro e busca (ou lista) à vontade naquela
+ * versão, que não muda mais. Escritores se revezam numa trava só deles;
+ * leitores nunca a tocam e nunca esperam.
+ *
+ * A versão antiga não pode ser liberada enquanto algum leitor ainda a usa.
+ * Para isso há épocas (reclamação por épocas, como no RCU): cada leitor
+ * tem um espaço próprio onde anuncia a época ao entrar e 0 ao sair. A
+ * versão trocada é aposentada com a época seguinte à troca e só é
+ * liberada quando todo leitor ativo anunciou uma época igual ou maior, o
+ * que garante que ele já pegou o ponteiro novo.
+ *
+ * A escrita é O(n) (cópia inteira); compensa quando as leituras são a
+ * grande maioria, que é o caso de buscas e listagens.
+ */
+
+#ifndef FREEFIRE_VERSOES_H
+#define FREEFIRE_VERSOES_H
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ordenacao.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define VERSOES_TEM_THREADS 1
+#else
+#define VERSOES_TEM_THREADS 0
+#endif
+
+#define VERSOES_MAX_LEITORES 64
+#define VERSOES_LINHA_CACHE 64
+
+// Uma versão publicada: imutável depois da publicação
+typedef struct Versao {
+    struct Versao *proximaAposentada;
+    unsigned long epocaAposentada; // liberável quando todo leitor ativo chegou nela
+    int tamanho;
+    size_t tamElem;
+    char *dados;                   // logo depois do cabeçalho
+} Versao;
+
+// Espaço de um leitor: época anunciada (0 = fora de leitura), numa linha própria
+typedef struct {
+    atomic_ulong epoca;
+    char separador[VERSOES_LINHA_CACHE - sizeof(atomic_ulong)];
+} EspacoLeitor;
+
+typedef struct {
+    _Atomic(Versao *) atual;
+    atomic_ulong epoca;          // começa em 1
+    atomic_int numLeitores;      // espaços já distribuídos
+    EspacoLeitor leitores[VERSOES_MAX_LEITORES];
+#if VERSOES_TEM_THREADS
+    pthread_mutex_t travaEscrita;
+#endif
+    Versao *aposentadas;         // lista protegida pela trava de escrita
+    int numAposentadas;
+    long publicacoes;
+    size_t tamElem;
+    Comparador cmp;              // ordem do vetor e das buscas
+} RegistrosVersionados;
+
+static inline Versao *versoes_nova(size_t tamElem, int tamanho) {
+    Versao *v = (Versao *)ordenacao_alocar(sizeof(Versao) + (size_t)tamanho * tamElem);
+    v->proximaAposentada = NULL;
+    v->epocaAposentada = 0;
+    v->tamanho = tamanho;
+    v->tamElem = tamElem;
+    v->dados = (char *)(v + 1);
+    return v;
+}
+
+static inline const void *versoes_em(const Versao *v, int i) {
+    return v->dados + (size_t)i * v->tamElem;
+}
+
+// Começa com os n registros de 'base', que já devem estar na ordem de cmp
+static inline void versoes_iniciar(RegistrosVersionados *r, size_t tamElem, Comparador cmp, const void *base,
+                                   int n) {
+    memset(r, 0, sizeof(*r));
+    r->tamElem = tamElem;
+    r->cmp = cmp;
+    Versao *v = versoes_nova(tamElem, n);
+    if (n > 0) memcpy(v->dados, base, (size_t)n * tamElem);
+    atomic_init(&r->atual, v);
+    atomic_init(&r->epoca, 1);
+    atomic_init(&r->numLeitores, 0);
+    for (int i = 0; i < VERSOES_MAX_LEITORES; i++) atomic_init(&r->leitores[i].epoca, 0);
+#if VERSOES_TEM_THREADS
+    pthread_mutex_init(&r->travaEscrita, NULL);
+#endif
+}
+
+// Só quando ninguém mais lê nem escreve
+static inline void versoes_liberar(RegistrosVersionados *r) {
+    while (r->aposentadas != NULL) {
+        Versao *v = r->aposentadas;
+        r->aposentadas = v->proximaAposentada;
+        free(v);
+    }
+    free(atomic_load(&r->atual));
+#if VERSOES_TEM_THREADS
+    pthread_mutex_destroy(&r->travaEscrita);
+#endif
+}
+
+// -----------------------------
+// Leitura: sem trava, sem espera
+// -----------------------------
+
+// Espaço de leitor para uma thread (uma vez por thread); -1 se acabaram
+static inline int versoes_registrarLeitor(RegistrosVersionados *r) {
+    int id = atomic_fetch_add(&r->numLeitores, 1);
+    if (id >= VERSOES_MAX_LEITORES) {
+        atomic_fetch_sub(&r->numLeitores, 1);
+        return -1;
+    }
+    return id;
+}
+
+// Entra numa leitura e devolve a versão atual, válida até versoes_sair().
+// A época é anunciada antes de ler o ponteiro: um escritor que não vê o
+// anúncio já publicou a versão nova antes, e é ela que o leitor pega.
+static inline const Versao *versoes_entrar(RegistrosVersionados *r, int leitor) {
+    atomic_store(&r->leitores[leitor].epoca, atomic_load(&r->epoca));
+    return atomic_load(&r->atual);
+}
+
+static inline void versoes_sair(RegistrosVersionados *r, int leitor) {
+    atomic_store_explicit(&r->leitores[leitor].epoca, 0, memory_order_release);
+}
+
+// Primeira posição com registro >= 'sonda' (na ordem de cmp)
+static inline int versoes_limiteInferior(const Versao *v, Comparador cmp, const void *sonda, long *comparacoes) {
+    int ini = 0, fim = v->tamanho;
+    while (ini < fim) {
+        int meio = ini + (fim - ini) / 2;
+        (*comparacoes)++;
+        if (cmp(versoes_em(v, meio), sonda) < 0) ini = meio + 1;
+        else fim = meio;
+    }
+    return ini;
+}
+
+// Busca binária numa versão: posição de um registro igual à sonda, ou -1
+static inline int versoes_buscar(const Versao *v, Comparador cmp, const void *sonda, long *comparacoes) {
+    *comparacoes = 0;
+    int i = versoes_limiteInferior(v, cmp, sonda, comparacoes);
+    if (i < v->tamanho) {
+        (*comparacoes)++;
+        if (cmp(versoes_em(v, i), sonda) == 0) return i;
+    }
+    return -1;
+}
+
+// Entra, busca, copia o registro achado para 'saida' e sai. Devolve 0 se não achou.
+static inline int versoes_buscarCopia(RegistrosVersionados *r, int leitor, const void *sonda, void *saida,
+                                      long *comparacoes) {
+    const Versao *v = versoes_entrar(r, leitor);
+    int i = versoes_buscar(v, r->cmp, sonda, comparacoes);
+    if (i >= 0 && saida != NULL) memcpy(saida, versoes_em(v, i), r->tamElem);
+    versoes_sair(r, leitor);
+    return i >= 0;
+}
+
+// -----------------------------
+// Escrita: cópia, publicação e aposentadoria da versão anterior
+// -----------------------------
+
+// Libera as aposentadas que nenhum leitor ativo pode estar usando
+static inline void versoes_recolher(RegistrosVersionados *r) {
+    unsigned long menor = (unsigned long)-1;
+    int leitores = atomic_load(&r->numLeitores);
+    if (leitores > VERSOES_MAX_LEITORES) leitores = VERSOES_MAX_LEITORES;
+    for (int i = 0; i < leitores; i++) {
+        unsigned long e = atomic_load(&r->leitores[i].epoca);
+        if (e != 0 && e < menor) menor = e;
+    }
+    Versao **p = &r->aposentadas;
+    while (*p != NULL) {
+        Versao *v = *p;
+        if (v->epocaAposentada <= menor) {
+            *p = v->proximaAposentada;
+            free(v);
+            r->numAposentadas--;
+        } else {
+            p = &v->proximaAposentada;
+        }
+    }
+}
+
+// Publica 'nova' no lugar da atual (trava de escrita já obtida)
+static inline void versoes_publicar(RegistrosVersionados *r, Versao *nova) {
+    Versao *antiga = atomic_exchange(&r->atual, nova);
+    // quem anunciar esta época (ou outra depois) já vai ler 'nova'
+    antiga->epocaAposentada = atomic_fetch_add(&r->epoca, 1) + 1;
+    antiga->proximaAposentada = r->aposentadas;
+    r->aposentadas = antiga;
+    r->numAposentadas++;
+    r->publicacoes++;
+    versoes_recolher(r);
+}
+
+static inline void versoes_travarEscrita(RegistrosVersionados *r) {
+#if VERSOES_TEM_THREADS
+    pthread_mutex_lock(&r->travaEscrita);
+#else
+    (void)r;
+#endif
+}
+
+static inline void versoes_destravarEscrita(RegistrosVersionados *r) {
+#if VERSOES_TEM_THREADS
+    pthread_mutex_unlock(&r->travaEscrita);
+#else
+    (void)r;
+#endif
+}
+
+// Insere uma cópia do registro na posição da ordem (depois dos iguais)
+// e publica a nova versão. Devolve a posição.
+static inline int versoes_inserir(RegistrosVersionados *r, const void *registro) {
+    versoes_travarEscrita(r);
+    Versao *v = atomic_load(&r->atual); // só escritores trocam: estável com a trava
+    int ini = 0, fim = v->tamanho;
+    while (ini < fim) {
+        int meio = ini + (fim - ini) / 2;
+        if (r->cmp(versoes_em(v, meio), registro) <= 0) ini = meio + 1;
+        else fim = meio;
+    }
+    Versao *nova = versoes_nova(r->tamElem, v->tamanho + 1);
+    size_t antes = (size_t)ini * r->tamElem;
+    memcpy(nova->dados, v->dados, antes);
+    memcpy(nova->dados + antes, registro, r->tamElem);
+    memcpy(nova->dados + antes + r->tamElem, v->dados + antes, (size_t)(v->tamanho - ini) * r->tamElem);
+    versoes_publicar(r, nova);
+    versoes_destravarEscrita(r);
+    return ini;
+}
+
+// Remove o primeiro registro igual à sonda (copiado em 'saida', se não for
+// NULL) e publica a nova versão. Devolve 0 se não havia nenhum.
+static inline int versoes_remover(RegistrosVersionados *r, const void *sonda, void *saida) {
+    versoes_travarEscrita(r);
+    Versao *v = atomic_load(&r->atual);
+    long comparacoes;
+    int i = versoes_buscar(v, r->cmp, sonda, &comparacoes);
+    if (i >= 0) {
+        if (saida != NULL) memcpy(saida, versoes_em(v, i), r->tamElem);
+        Versao *nova = versoes_nova(r->tamElem, v->tamanho - 1);
+        size_t antes = (size_t)i * r->tamElem;
+        memcpy(nova->dados, v->dados, antes);
+        memcpy(nova->dados + antes, v->dados + antes + r->tamElem, (size_t)(v->tamanho - i - 1) * r->tamElem);
+        versoes_publicar(r, nova);
+    }
+    versoes_destravarEscrita(r);
+    return i >= 0;
+}
+
+#endif
@@ -0,0 +1,486 @@
+/* wal.h
+ *
+ * Log de operações só de acréscimo (write-ahead log): cada inserção ou
+ * remoção vira um registro pequeno no fim do arquivo, e o inventário
+ * inteiro só é regravado (como snapshot, ver snapshot.h) na compactação.
+ *
+ * Arquivo: cabeçalho de 24 bytes (mágica, tipo, versão) seguido de
+ * registros {checksum, tamanho, op, sequência} + dados, completados até
+ * múltiplo de 8 bytes (os dados reproduzidos ficam alinhados). A
+ * sequência cresce a cada operação; o snapshot guarda a última que já
+ * contém, e a reprodução pula as que não são posteriores a ela.
+ *
+ * Commit em grupo: os registros se acumulam num buffer e vão ao disco
+ * juntos (um write e um fdatasync) quando o grupo chega a
+ * WAL_GRUPO_MAXIMO registros ou o mais antigo passa de
+ * WAL_GRUPO_INTERVALO_NS. A idade é conferida a cada registro e, quando
+ * o programa vai esperar por entrada, por wal_prazoNs(): quem espera deve
+ * acordar no prazo e chamar wal_sincronizar() (o modo lote faz isso com
+ * lote_aguardarComando). wal_sincronizar() força o commit; sem ele, uma
+ * queda perde no máximo o último grupo.
+ *
+ * Reprodução (wal_abrir): lê até o primeiro registro incompleto ou com
+ * checksum errado (gravação interrompida) e corta o arquivo ali.
+ *
+ * Compactação: quando o log cresce mais que o limite ou que o último
+ * snapshot (o que for maior: o custo de regravar fica proporcional ao que
+ * o log acumulou), um processo filho (fork,
+ * que vê o estado daquele instante) grava o snapshot enquanto o programa
+ * continua registrando. Quando o filho termina, o log é reescrito só com
+ * os registros posteriores (temporário + rename), com fsync do diretório
+ * antes (o rename do snapshot) e depois (o do log). Uma queda em qualquer
+ * ponto deixa snapshot + log reproduzíveis.
+ *
+ * Requer POSIX (fork, fdatasync); em outras plataformas wal_abrir() recusa.
+ * Com -std=c11 quem inclui deve definir _POSIX_C_SOURCE 200809L (ou
+ * _GNU_SOURCE) antes de qualquer #include, senão pread e companhia ficam
+ * sem declaração.
+ */
+
+#ifndef FREEFIRE_WAL_H
+#define FREEFIRE_WAL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cronometro.h"
+#include "snapshot.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define WAL_DISPONIVEL 1
+#else
+#define WAL_DISPONIVEL 0
+#endif
+
+#define WAL_MAGICA "FFWAL\r\n"  // 8 bytes com o '\0'
+#define WAL_VERSAO 1
+
+#define WAL_GRUPO_MAXIMO 1024               // registros por commit
+#define WAL_GRUPO_INTERVALO_NS 2000000LL    // idade máxima do grupo (2 ms)
+#define WAL_LIMITE_COMPACTACAO (4L << 20)   // bytes de log antes de compactar
+#define WAL_DADOS_MAX 0xFFFF
+
+// Operações usadas pelos níveis (o log só guarda o número)
+#define WAL_OP_INSERIR 1
+#define WAL_OP_REMOVER 2
+#define WAL_OP_ORDENAR 3
+
+typedef struct {
+    char magica[8];
+    char tipo[8];
+    uint32_t versao;
+    uint32_t reservado;
+} CabecalhoWal;
+
+typedef struct {
+    uint32_t checksum;  // dos bytes seguintes do registro (cabeçalho + dados)
+    uint16_t tamanho;   // bytes de dados
+    uint8_t op;
+    uint8_t reservado;
+    uint64_t sequencia;
+} RegistroWal;
+
+// Aplica uma operação reproduzida do log
+typedef void (*AplicarOperacao)(void *contexto, int op, const void *dados, size_t tamanho);
+
+// Grava o estado atual como snapshot contendo até 'sequencia'. Roda no
+// processo filho da compactação. Retorna 1 se gravou.
+typedef int (*GravarCompactacao)(void *contexto, const char *caminhoSnapshot, uint64_t sequencia);
+
+typedef struct {
+    int fd;                     // -1: log desligado (wal_registrar não faz nada)
+    char *caminho;
+    uint64_t sequencia;         // última operação registrada
+    unsigned char *buffer;      // registros do grupo ainda não gravados
+    size_t usado, capacidade;
+    int pendentes;
+    long long inicioGrupoNs;
+    long long tamanho;          // bytes já gravados no arquivo
+    // compactação
+    long limite;
+    long long gatilho;          // tamanho que dispara a próxima compactação
+    char *caminhoSnapshot;
+    GravarCompactacao gravar;
+    void *contextoGravar;
+    int compactador;            // pid do filho gravando o snapshot (0: nenhum)
+    long long inicioCauda;      // primeiro registro que o snapshot em curso não contém
+    // estatísticas
+    long long commits;
+    long long compactacoes;
+} Wal;
+
+static inline void wal_iniciar(Wal *w) {
+    memset(w, 0, sizeof(*w));
+    w->fd = -1;
+    w->limite = WAL_LIMITE_COMPACTACAO;
+    w->gatilho = WAL_LIMITE_COMPACTACAO;
+}
+
+static inline int wal_ativo(const Wal *w) {
+    return w->fd >= 0;
+}
+
+// Bytes que um registro ocupa no arquivo
+static inline size_t wal_tamanhoRegistro(size_t tamDados) {
+    return (sizeof(RegistroWal) + tamDados + 7) & ~(size_t)7;
+}
+
+static inline uint32_t wal_checksum(const unsigned char *registro, size_t tam) {
+    uint64_t h = snapshot_checksum(registro + sizeof(uint32_t), tam - sizeof(uint32_t));
+    return (uint32_t)(h ^ (h >> 32));
+}
+
+static inline char *wal_copiarTexto(const char *s) {
+    size_t n = strlen(s) + 1;
+    char *c = (char *)malloc(n);
+    if (c == NULL) {
+        fprintf(stderr, "Memória insuficiente (log).\n");
+        exit(1);
+    }
+    return (char *)memcpy(c, s, n);
+}
+
+#if WAL_DISPONIVEL
+
+static inline void wal_falhar(const Wal *w, const char *acao) {
+    // sem o log no disco a operação não é durável: não dá para continuar
+    fprintf(stderr, "Falha ao %s o log '%s'.\n", acao, w->caminho);
+    exit(1);
+}
+
+static inline int wal_escreverTudo(int fd, const void *dados, size_t tam) {
+    const char *p = (const char *)dados;
+    while (tam > 0) {
+        ssize_t n = write(fd, p, tam);
+        if (n < 0) return 0;
+        p += n;
+        tam -= (size_t)n;
+    }
+    return 1;
+}
+
+static inline int wal_durar(int fd) {
+#if defined(__APPLE__)
+    return fsync(fd) == 0;
+#else
+    return fdatasync(fd) == 0;
+#endif
+}
+
+// Torna duráveis as entradas (renames) do diretório que contém 'caminho'
+static inline int wal_durarDiretorio(const char *caminho) {
+    const char *barra = strrchr(caminho, '/');
+    char *dir = wal_copiarTexto(barra == NULL ? "." : caminho);
+    if (barra != NULL) dir[barra == caminho ? 1 : (size_t)(barra - caminho)] = '\0'; // "/x" -> "/"
+    int fd = open(dir, O_RDONLY);
+    int ok = fd >= 0 && fsync(fd) == 0;
+    if (fd >= 0) close(fd);
+    free(dir);
+    return ok;
+}
+
+static inline void wal_cabecalho(CabecalhoWal *c, const char *tipo) {
+    memset(c, 0, sizeof(*c));
+    memcpy(c->magica, WAL_MAGICA, 8);
+    size_t len = strlen(tipo); // o resto de c->tipo fica zerado
+    memcpy(c->tipo, tipo, len < sizeof(c->tipo) ? len : sizeof(c->tipo));
+    c->versao = WAL_VERSAO;
+}
+
+// Grava o grupo pendente e espera o disco confirmar
+static inline void wal_sincronizar(Wal *w) {
+    if (w->fd < 0 || w->usado == 0) return;
+    if (!wal_escreverTudo(w->fd, w->buffer, w->usado) || !wal_durar(w->fd)) wal_falhar(w, "gravar");
+    w->tamanho += (long long)w->usado;
+    w->usado = 0;
+    w->pendentes = 0;
+    w->commits++;
+}
+
+// Reproduz o log e o deixa aberto para acréscimo. Operações com sequência
+// até 'desde' (já contidas no snapshot) são puladas. Retorna quantas foram
+// aplicadas, ou -1 se o arquivo não for um log do tipo esperado.
+static inline int wal_abrir(Wal *w, const char *caminho, const char *tipo, uint64_t desde,
+                            AplicarOperacao aplicar, void *contexto) {
+    wal_iniciar(w);
+    w->caminho = wal_copiarTexto(caminho);
+    w->sequencia = desde;
+
+    int fd = open(caminho, O_RDWR | O_CREAT | O_APPEND, 0644);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr, "Não foi possível abrir o log '%s'.\n", caminho);
+        if (fd >= 0) close(fd);
+        free(w->caminho);
+        wal_iniciar(w);
+        return -1;
+    }
+    w->fd = fd;
+
+    CabecalhoWal esperado;
+    wal_cabecalho(&esperado, tipo);
+    size_t tam = (size_t)st.st_size;
+    if (tam < sizeof(CabecalhoWal)) {
+        // log novo (ou cabeçalho interrompido): começa do zero
+        if (ftruncate(fd, 0) != 0 || !wal_escreverTudo(fd, &esperado, sizeof(esperado)) || !wal_durar(fd))
+            wal_falhar(w, "criar");
+        w->tamanho = sizeof(esperado);
+        return 0;
+    }
+
+    unsigned char *conteudo = (unsigned char *)malloc(tam);
+    if (conteudo == NULL) {
+        fprintf(stderr, "Memória insuficiente (log).\n");
+        exit(1);
+    }
+    size_t lido = 0;
+    while (lido < tam) {
+        ssize_t n = pread(fd, conteudo + lido, tam - lido, (off_t)lido);
+        if (n <= 0) break;
+        lido += (size_t)n;
+    }
+    if (lido != tam || memcmp(conteudo, &esperado, sizeof(esperado)) != 0) {
+        fprintf(stderr, "Log '%s' inválido: cabeçalho ou tipo não confere.\n", caminho);
+        free(conteudo);
+        close(fd);
+        free(w->caminho);
+        wal_iniciar(w);
+        return -1;
+    }
+
+    int aplicadas = 0;
+    size_t pos = sizeof(CabecalhoWal);
+    while (pos + sizeof(RegistroWal) <= tam) {
+        RegistroWal r;
+        memcpy(&r, conteudo + pos, sizeof(r));
+        size_t total = wal_tamanhoRegistro(r.tamanho);
+        if (pos + total > tam || wal_checksum(conteudo + pos, total) != r.checksum) break;
+        if (r.sequencia > w->sequencia) {
+            aplicar(contexto, r.op, conteudo + pos + sizeof(r), r.tamanho);
+            w->sequencia = r.sequencia;
+            aplicadas++;
+        }
+        pos += total;
+    }
+    free(conteudo);
+
+    if (pos < tam) {
+        fprintf(stderr, "Log '%s': %zu bytes finais incompletos descartados.\n", caminho, tam - pos);
+        if (ftruncate(fd, (off_t)pos) != 0 || !wal_durar(fd)) wal_falhar(w, "cortar");
+    }
+    w->tamanho = (long long)pos;
+    return aplicadas;
+}
+
+// Próxima compactação: depois de o log crescer max(limite, snapshot atual)
+static inline void wal_programarCompactacao(Wal *w) {
+    long long passo = w->limite;
+    struct stat st;
+    if (w->caminhoSnapshot != NULL && stat(w->caminhoSnapshot, &st) == 0 && st.st_size > passo)
+        passo = (long long)st.st_size;
+    w->gatilho = w->tamanho + passo;
+}
+
+// Liga a compactação: passado 'limite' bytes, 'gravar' escreve o snapshot
+static inline void wal_definirCompactacao(Wal *w, const char *caminhoSnapshot, long limite,
+                                          GravarCompactacao gravar, void *contexto) {
+    free(w->caminhoSnapshot);
+    w->caminhoSnapshot = wal_copiarTexto(caminhoSnapshot);
+    w->limite = limite;
+    w->gravar = gravar;
+    w->contextoGravar = contexto;
+    wal_programarCompactacao(w);
+}
+
+// Reescreve o log só com os registros que o snapshot recém-gravado não contém
+static inline void wal_reescreverCauda(Wal *w) {
+    wal_sincronizar(w);
+    size_t len = strlen(w->caminho);
+    char *temporario = (char *)malloc(len + 5);
+    if (temporario == NULL) {
+        fprintf(stderr, "Memória insuficiente (log).\n");
+        exit(1);
+    }
+    memcpy(temporario, w->caminho, len);
+    memcpy(temporario + len, ".tmp", 5);
+
+    // o cabeçalho é o mesmo do log atual
+    CabecalhoWal c;
+    int novo = open(temporario, O_RDWR | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    int ok = novo >= 0 && pread(w->fd, &c, sizeof(c), 0) == (ssize_t)sizeof(c) &&
+             wal_escreverTudo(novo, &c, sizeof(c));
+    char bloco[1 << 16];
+    long long pos = w->inicioCauda;
+    while (ok && pos < w->tamanho) {
+        size_t quer = (size_t)(w->tamanho - pos) < sizeof(bloco) ? (size_t)(w->tamanho - pos) : sizeof(bloco);
+        ssize_t n = pread(w->fd, bloco, quer, (off_t)pos);
+        ok = n > 0 && wal_escreverTudo(novo, bloco, (size_t)n);
+        pos += n;
+    }
+    // o snapshot do filho já foi renomeado: o rename precisa durar antes de
+    // o log perder os registros que ele contém
+    if (ok) ok = wal_durar(novo) && wal_durarDiretorio(w->caminhoSnapshot) && rename(temporario, w->caminho) == 0;
+    if (ok) {
+        if (!wal_durarDiretorio(w->caminho)) wal_falhar(w, "trocar");
+        close(w->fd);
+        w->fd = novo;
+        w->tamanho = (long long)sizeof(c) + (w->tamanho - w->inicioCauda);
+        wal_programarCompactacao(w);
+        w->compactacoes++;
+    } else {
+        // o log antigo continua completo; tenta de novo no próximo limite
+        fprintf(stderr, "Não foi possível reescrever o log '%s'.\n", w->caminho);
+        if (novo >= 0) close(novo);
+        remove(temporario);
+    }
+    free(temporario);
+}
+
+// Confere se o filho da compactação terminou (sem esperar, salvo 'esperar')
+static inline void wal_verificarCompactacao(Wal *w, int esperar) {
+    if (w->compactador == 0) return;
+    int status;
+    pid_t r = waitpid((pid_t)w->compactador, &status, esperar ? 0 : WNOHANG);
+    if (r == 0) return;
+    w->compactador = 0;
+    if (r > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0) wal_reescreverCauda(w);
+    else fprintf(stderr, "Compactação do log '%s' falhou; o log continua válido.\n", w->caminho);
+}
+
+// Dispara a compactação em segundo plano
+static inline void wal_compactar(Wal *w) {
+    if (w->gravar == NULL || w->compactador != 0) return;
+    wal_sincronizar(w); // o snapshot não pode conter o que o log não tem
+    fflush(NULL);       // o filho herda os buffers de saída: não duplicar
+    w->inicioCauda = w->tamanho;
+    wal_programarCompactacao(w); // se falhar, só tenta de novo depois de outro passo
+    pid_t pid = fork();
+    if (pid == 0) {
+        int ok = w->gravar(w->contextoGravar, w->caminhoSnapshot, w->sequencia);
+        _exit(ok ? 0 : 1);
+    }
+    if (pid < 0) {
+        // sem processo filho: compacta aqui mesmo
+        if (w->gravar(w->contextoGravar, w->caminhoSnapshot, w->sequencia)) wal_reescreverCauda(w);
+        return;
+    }
+    w->compactador = (int)pid;
+}
+
+// Nanossegundos até o grupo pendente vencer (0 se já venceu); -1 se não
+// há nada pendente. Quem vai esperar por entrada não deve passar disso.
+static inline long long wal_prazoNs(const Wal *w) {
+    if (w->fd < 0 || w->pendentes == 0) return -1;
+    long long resta = w->inicioGrupoNs + WAL_GRUPO_INTERVALO_NS - cronometro_agoraNs();
+    return resta > 0 ? resta : 0;
+}
+
+// Grava o grupo pendente se ele já passou da idade máxima
+static inline void wal_sincronizarVencido(Wal *w) {
+    if (wal_prazoNs(w) == 0) wal_sincronizar(w);
+}
+
+// Acrescenta uma operação ao grupo atual (nada, se o log estiver desligado)
+static inline void wal_registrar(Wal *w, int op, const void *dados, size_t tamanho) {
+    if (w->fd < 0) return;
+    if (tamanho > WAL_DADOS_MAX) wal_falhar(w, "registrar (dados grandes demais)");
+
+    size_t total = wal_tamanhoRegistro(tamanho);
+    if (w->usado + total > w->capacidade) {
+        size_t nova = w->capacidade ? w->capacidade * 2 : 4096;
+        while (nova < w->usado + total) nova *= 2;
+        unsigned char *b = (unsigned char *)realloc(w->buffer, nova);
+        if (b == NULL) {
+            fprintf(stderr, "Memória insuficiente (log).\n");
+            exit(1);
+        }
+        w->buffer = b;
+        w->capacidade = nova;
+    }
+
+    RegistroWal r;
+    memset(&r, 0, sizeof(r));
+    r.tamanho = (uint16_t)tamanho;
+    r.op = (uint8_t)op;
+    r.sequencia = ++w->sequencia;
+    unsigned char *destino = w->buffer + w->usado;
+    memcpy(destino, &r, sizeof(r));
+    memset(destino + sizeof(r), 0, total - sizeof(r));
+    if (tamanho > 0) memcpy(destino + sizeof(r), dados, tamanho);
+    r.checksum = wal_checksum(destino, total);
+    memcpy(destino, &r.checksum, sizeof(r.checksum));
+    w->usado += total;
+
+    long long agora = cronometro_agoraNs();
+    if (w->pendentes++ == 0) w->inicioGrupoNs = agora;
+    if (w->pendentes >= WAL_GRUPO_MAXIMO || agora - w->inicioGrupoNs >= WAL_GRUPO_INTERVALO_NS)
+        wal_sincronizar(w);
+
+    wal_verificarCompactacao(w, 0);
+    if (w->tamanho + (long long)w->usado >= w->gatilho) wal_compactar(w);
+}
+
+// Grava o que falta, espera a compactação em curso e fecha o log
+static inline void wal_fechar(Wal *w) {
+    if (w->fd >= 0) {
+        wal_sincronizar(w);
+        wal_verificarCompactacao(w, 1);
+        close(w->fd);
+    }
+    free(w->buffer);
+    free(w->caminho);
+    free(w->caminhoSnapshot);
+    wal_iniciar(w);
+}
+
+#else
+
+static inline void wal_sincronizar(Wal *w) { (void)w; }
+
+static inline long long wal_prazoNs(const Wal *w) {
+    (void)w;
+    return -1;
+}
+
+static inline void wal_sincronizarVencido(Wal *w) { (void)w; }
+
+static inline int wal_abrir(Wal *w, const char *caminho, const char *tipo, uint64_t desde,
+                            AplicarOperacao aplicar, void *contexto) {
+    (void)tipo; (void)desde; (void)aplicar; (void)contexto;
+    wal_iniciar(w);
+    fprintf(stderr, "Log '%s' indisponível: requer um sistema POSIX.\n", caminho);
+    return -1;
+}
+
+static inline void wal_definirCompactacao(Wal *w, const char *caminhoSnapshot, long limite,
+                                          GravarCompactacao gravar, void *contexto) {
+    (void)w; (void)caminhoSnapshot; (void)limite; (void)gravar; (void)contexto;
+}
+
+static inline void wal_registrar(Wal *w, int op, const void *dados, size_t tamanho) {
+    (void)w; (void)op; (void)dados; (void)tamanho;
+}
+
+static inline void wal_fechar(Wal *w) {
+    wal_iniciar(w);
+}
+
+#endif
+
+// Valor de --wal <base> na linha de comando (NULL se ausente). O log fica
+// em <base>.log e o snapshot da compactação em <base>.snap.
+static inline const char *wal_argumento(int argc, char *argv[]) {
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--wal") == 0) return argv[i + 1];
+    }
+    return NULL;
+}
+
+#endif
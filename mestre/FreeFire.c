@@ -2,83 +2,227 @@
  *
  * Sistema de priorização e montagem de componentes da torre de fuga.
  * Implementa ordenações (Bubble, Insertion, Selection), mede comparações
- * e tempo de execução, e realiza busca binária por nome após ordenação por nome.
+ * e tempo de execução, e realiza busca binária (e por começo do nome, para
+ * autocompletar) após ordenação por nome.
+ * Para inventários grandes há Introsort e Merge Sort (../comum/ordenacao.h),
+ * que ordenam um vetor de índices e movem cada componente uma única vez, e
+ * um Merge Sort paralelo num pool fixo de threads (../comum/paralelo.h).
+ * Nomes e tipos são comparados como campos de largura fixa, 16 bytes por
+ * vez (../comum/chave.h). Para ordenar por vários critérios de uma vez,
+ * cada componente vira uma chave binária comparada com um único memcmp
+ * (../comum/chavenormal.h).
+ *
+ * Os componentes ficam num Inventario crescente apoiado em arena
+ * (../comum/inventario.h), sem limite fixo de quantidade. Para ordenar há
+ * também um layout colunar (ColunasComponentes), com um vetor contíguo por
+ * campo: chaves inteiras são lidas sem arrastar os textos. Ele é uma cópia
+ * derivada do inventário, refeita a cada uso, e o tempo medido inclui essa
+ * transposição.
+ * Duas árvores B (../comum/arvoreb.h), por nome e por prioridade, guardam
+ * cópias dos componentes e respondem consultas por faixa sem ordenar.
+ * O tipo é internado num dicionário (../comum/dicionario.h): cada
+ * componente guarda um id de 16 bits, ordenar por tipo compara inteiros e
+ * cada tipo tem um balde com seus componentes.
+ * A fila de montagem é um heap (../comum/heap.h): o próximo componente a
+ * montar (maior prioridade) é conhecido em O(1), e os K mais importantes
+ * saem em O(n log K) sem ordenar o vetor. Montar ou mudar a prioridade é
+ * O(log n) no heap e nas árvores, mas O(n) no total: o vetor e o balde do
+ * tipo não guardam posições e são varridos.
+ *
+ * O estoque pode ser salvo num snapshot binário (../comum/snapshot.h) e
+ * recarregado por mmap, sem redigitar nada:
+ *   ./torre_resgate --snapshot estoque.bin   (carrega ao iniciar, salva ao sair)
+ *   ./torre_resgate --lote cmds.txt --snapshot estoque.bin
+ *
+ * Os tempos usam relógio monotônico em nanossegundos (../comum/cronometro.h)
+ * e alimentam histogramas por operação, exibidos na opção "Estatísticas".
+ *
+ * Também roda sem menus: ./torre_resgate --lote [arquivo] (ver executarLote).
  *
  * Compile:
- *   gcc torre_resgate.c -o torre_resgate
+ *   gcc torre_resgate.c -o torre_resgate -pthread
  * Execute:
  *   ./torre_resgate
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // afinidade de CPU das threads (../comum/paralelo.h)
+#endif
+
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
+#include <limits.h>
+
+#include "../comum/inventario.h"
+#include "../comum/ordenacao.h"
+#include "../comum/paralelo.h"
+#include "../comum/arvoreb.h"
+#include "../comum/chave.h"
+#include "../comum/chavenormal.h"
+#include "../comum/dicionario.h"
+#include "../comum/heap.h"
+#include "../comum/snapshot.h"
+#include "../comum/entrada.h"
+#include "../comum/lote.h"
+#include "../comum/cronometro.h"
+#include "../comum/tabela.h"
 
-#define MAX_COMPONENTES 20
 #define STRLEN 30
 #define TYPELEN 20
+#define LISTAGEM_MAXIMA 20 // linhas mostradas depois de cada ordenação (opção 1 lista tudo)
 
 // -----------------------------
 // Estrutura de componente
 // -----------------------------
 typedef struct {
     char nome[STRLEN];
-    char tipo[TYPELEN];
+    uint16_t tipo;  // id em tiposComponentes
     int prioridade; // 1 .. 10
+    int quantidade;
 } Componente;
 
+// Tipos dos componentes: cada texto é guardado uma vez e os componentes
+// guardam só o id (../comum/dicionario.h). Ordenar por tipo compara a
+// posição alfabética dos ids, sem tocar nos textos.
+Dicionario tiposComponentes;
+
+const char *textoTipo(int id) {
+    return dicionario_texto(&tiposComponentes, id);
+}
+
+int ordemTipo(int id) {
+    return dicionario_ordem(&tiposComponentes, id);
+}
+
+// Id do tipo (criado se for novo); -1 se não cabem mais tipos
+int internarTipo(const char *texto) {
+    int id = dicionario_internar(&tiposComponentes, texto);
+    if (id < 0) fprintf(stderr, "Tipos demais (máximo %d).\n", DICIONARIO_MAXIMO);
+    return id;
+}
+
+// Critérios de ordenação disponíveis
+typedef enum {
+    CRITERIO_NOME,
+    CRITERIO_TIPO,
+    CRITERIO_PRIORIDADE,
+    CRITERIO_QUANTIDADE
+} CriterioOrdenacao;
+
+// -----------------------------
+// Estatísticas de tempo por operação (opção 9)
+// -----------------------------
+typedef enum {
+    EST_CADASTRO,
+    EST_ORDENACAO,
+    EST_FASE_INDICES,     // ordenação por índice: fase de ordenar a permutação
+    EST_FASE_PERMUTACAO,  // ordenação por índice: fase de mover os componentes
+    EST_BUSCA_BINARIA,
+    EST_BUSCA_PREFIXO,    // faixa de prefixo no vetor ordenado
+    EST_CONSULTA_FAIXA,   // consultas nas árvores B
+    EST_REMOCAO,
+    EST_FILA_MONTAGEM,    // heap: inserir, retirar, atualizar e top-K
+    NUM_ESTATISTICAS
+} TipoEstatistica;
+
+Histograma estatisticas[NUM_ESTATISTICAS];
+
+void iniciarEstatisticas(void) {
+    histograma_iniciar(&estatisticas[EST_CADASTRO], "Cadastro");
+    histograma_iniciar(&estatisticas[EST_ORDENACAO], "Ordenação (total)");
+    histograma_iniciar(&estatisticas[EST_FASE_INDICES], "  fase: ordenar índices");
+    histograma_iniciar(&estatisticas[EST_FASE_PERMUTACAO], "  fase: aplicar permutação");
+    histograma_iniciar(&estatisticas[EST_BUSCA_BINARIA], "Busca binária");
+    histograma_iniciar(&estatisticas[EST_BUSCA_PREFIXO], "Busca por prefixo (vetor)");
+    histograma_iniciar(&estatisticas[EST_CONSULTA_FAIXA], "Consulta por faixa (árvore B)");
+    histograma_iniciar(&estatisticas[EST_REMOCAO], "Remoção");
+    histograma_iniciar(&estatisticas[EST_FILA_MONTAGEM], "Fila de montagem (heap)");
+}
+
+void mostrarEstatisticas(void) {
+    printf("\n----- Estatísticas de tempo (relógio monotônico) -----\n");
+    histograma_imprimirTabela(estatisticas, NUM_ESTATISTICAS);
+    for (int i = 0; i < NUM_ESTATISTICAS; i++) histograma_imprimirBarras(&estatisticas[i]);
+}
+
 // -----------------------------
 // Funções utilitárias
 // -----------------------------
 
-// Remove newline de fgets
-void trim_newline(char *s) {
-    size_t len = strlen(s);
-    if (len == 0) return;
-    if (s[len-1] == '\n') s[len-1] = '\0';
+// Tabelas de componentes: as linhas vão para o buffer de saída
+// (../comum/tabela.h) e saem num único write no fim da listagem
+
+void imprimirTitulosComponentes(const char *primeira) {
+    BufferSaida *s = &saida_tabela;
+    saida_linha(s);
+    saida_coluna(s, primeira, 3);
+    saida_texto(s, " | Nome                         | Tipo         | Prioridade | Qtd  \n");
 }
 
-// Mostra o vetor de componentes formatado
-void mostrarComponentes(Componente arr[], int n) {
-    printf("\n----- Componentes (total: %d) -----\n", n);
+// Cabeçalho da tabela de componentes; devolve 0 se não há o que listar
+int imprimirCabecalhoComponentes(int n) {
+    BufferSaida *s = &saida_tabela;
+    saida_linha(s);
+    saida_texto(s, "\n----- Componentes (total: ");
+    saida_inteiro(s, n, 0);
+    saida_texto(s, ") -----\n");
     if (n == 0) {
-        printf("Nenhum componente cadastrado.\n");
-        return;
+        saida_texto(s, "Nenhum componente cadastrado.\n");
+        saida_descarregar(s);
+        return 0;
     }
-    printf("%-3s | %-28s | %-12s | %-9s\n", "Idx", "Nome", "Tipo", "Prioridade");
-    printf("----+------------------------------+--------------+-----------\n");
-    for (int i = 0; i < n; i++) {
-        printf("%-3d | %-28s | %-12s | %-9d\n",
-               i, arr[i].nome, arr[i].tipo, arr[i].prioridade);
+    imprimirTitulosComponentes("Idx");
+    saida_texto(s, "----+------------------------------+--------------+------------+------\n");
+    return 1;
+}
+
+void imprimirLinhaComponente(int i, const char *nome, const char *tipo, int prioridade, int quantidade) {
+    BufferSaida *s = &saida_tabela;
+    saida_linha(s);
+    saida_inteiro(s, i, 3);
+    saida_texto(s, " | ");
+    saida_coluna(s, nome, 28);
+    saida_texto(s, " | ");
+    saida_coluna(s, tipo, 12);
+    saida_texto(s, " | ");
+    saida_inteiro(s, prioridade, 10);
+    saida_texto(s, " | ");
+    saida_inteiro(s, quantidade, 5);
+    saida_caractere(s, '\n');
+}
+
+// Fecha a tabela: linha final, aviso das linhas cortadas e um write
+void fecharTabelaComponentes(int exibidos, int total) {
+    BufferSaida *s = &saida_tabela;
+    saida_linha(s);
+    saida_texto(s, "----------------------------------------\n");
+    saida_restantes(s, total - exibidos, "opção 1 lista todos");
+    saida_descarregar(s);
+}
+
+// Mostra os 'limite' primeiros componentes (limite <= 0: todos)
+void mostrarComponentes(Componente arr[], int n, int limite) {
+    if (!imprimirCabecalhoComponentes(n)) return;
+    int exibir = limite > 0 && limite < n ? limite : n;
+    for (int i = 0; i < exibir; i++) {
+        imprimirLinhaComponente(i, arr[i].nome, textoTipo(arr[i].tipo), arr[i].prioridade, arr[i].quantidade);
     }
-    printf("----------------------------------------\n");
+    fecharTabelaComponentes(exibir, n);
 }
 
-// Le uma linha com fgets e remove newline; com prompt
+// Lê uma linha com prompt (../comum/entrada.h: leitura em blocos, sem
+// stdio); vazia se a entrada acabou
 void lerString(const char *prompt, char *out, int maxlen) {
-    char buf[256];
-    printf("%s", prompt);
-    if (fgets(buf, sizeof(buf), stdin) == NULL) {
-        out[0] = '\0';
-        return;
-    }
-    trim_newline(buf);
-    // garantir truncamento seguro
-    strncpy(out, buf, maxlen-1);
-    out[maxlen-1] = '\0';
+    entrada_lerTexto(prompt, out, maxlen);
 }
 
-// Lê inteiro com prompt usando fgets + sscanf (evita misturar scanf/fgets)
+// Lê inteiro com prompt, repetindo até ser válido; 0 se a entrada acabou
 int lerInteiro(const char *prompt) {
-    char buf[128];
     int v;
-    while (1) {
-        printf("%s", prompt);
-        if (fgets(buf, sizeof(buf), stdin) == NULL) return 0;
-        if (sscanf(buf, "%d", &v) == 1) return v;
-        printf("Entrada inválida. Digite um número inteiro.\n");
-    }
+    entrada_lerInteiro(prompt, &v);
+    return v;
 }
 
 // -----------------------------
@@ -92,7 +236,7 @@ void bubbleSortNome(Componente arr[], int n, long *comparacoes) {
         int trocou = 0;
         for (int j = 0; j < n - 1 - i; j++) {
             (*comparacoes)++;
-            if (strcmp(arr[j].nome, arr[j+1].nome) > 0) {
+            if (chave_comparar(arr[j].nome, arr[j+1].nome, STRLEN) > 0) {
                 Componente tmp = arr[j];
                 arr[j] = arr[j+1];
                 arr[j+1] = tmp;
@@ -103,7 +247,7 @@ void bubbleSortNome(Componente arr[], int n, long *comparacoes) {
     }
 }
 
-// Insertion sort por tipo (string). Conta comparações de strcmp via *comparacoes.
+// Insertion sort por tipo (posição alfabética do id). Conta comparações via *comparacoes.
 void insertionSortTipo(Componente arr[], int n, long *comparacoes) {
     *comparacoes = 0;
     for (int i = 1; i < n; i++) {
@@ -112,7 +256,7 @@ void insertionSortTipo(Componente arr[], int n, long *comparacoes) {
         // comparar tipos; cada comparação com arr[j].tipo conta
         while (j >= 0) {
             (*comparacoes)++;
-            if (strcmp(arr[j].tipo, chave.tipo) > 0) {
+            if (ordemTipo(arr[j].tipo) > ordemTipo(chave.tipo)) {
                 arr[j+1] = arr[j];
                 j--;
             } else {
@@ -142,18 +286,557 @@ void selectionSortPrioridade(Componente arr[], int n, long *comparacoes) {
     }
 }
 
+// -----------------------------
+// Ordenações O(n log n) por índice (Introsort e Merge Sort estável)
+// Ordenam uma permutação de índices e depois reposicionam os componentes.
+// Mesma assinatura das anteriores para caber em SortFunc/medirTempo.
+// -----------------------------
+
+int compararNome(const void *a, const void *b) {
+    return chave_comparar(((const Componente *)a)->nome, ((const Componente *)b)->nome, STRLEN);
+}
+
+int compararTipo(const void *a, const void *b) {
+    int ta = ordemTipo(((const Componente *)a)->tipo), tb = ordemTipo(((const Componente *)b)->tipo);
+    return (ta > tb) - (ta < tb);
+}
+
+int compararPrioridade(const void *a, const void *b) {
+    int pa = ((const Componente *)a)->prioridade, pb = ((const Componente *)b)->prioridade;
+    return (pa > pb) - (pa < pb);
+}
+
+// estavel = 1 usa Merge Sort; 0 usa Introsort
+void ordenarPorIndice(Componente arr[], int n, long *comparacoes, Comparador cmp, int estavel) {
+    *comparacoes = 0;
+    if (n < 2) return;
+    int *perm = (int *)ordenacao_alocar((size_t)n * sizeof(int));
+    Medicao m = medicao_iniciar();
+    ordenacao_identidade(perm, n);
+    if (estavel) *comparacoes = ordenacao_mergesort(arr, sizeof(Componente), perm, n, cmp);
+    else *comparacoes = ordenacao_introsort(arr, sizeof(Componente), perm, n, cmp);
+    medicao_registrar(&m, &estatisticas[EST_FASE_INDICES]);
+
+    m = medicao_iniciar();
+    ordenacao_aplicarPermutacao(arr, sizeof(Componente), perm, n);
+    medicao_registrar(&m, &estatisticas[EST_FASE_PERMUTACAO]);
+    free(perm);
+}
+
+void introSortNome(Componente arr[], int n, long *comparacoes) {
+    ordenarPorIndice(arr, n, comparacoes, compararNome, 0);
+}
+
+void introSortTipo(Componente arr[], int n, long *comparacoes) {
+    ordenarPorIndice(arr, n, comparacoes, compararTipo, 0);
+}
+
+void introSortPrioridade(Componente arr[], int n, long *comparacoes) {
+    ordenarPorIndice(arr, n, comparacoes, compararPrioridade, 0);
+}
+
+void mergeSortNome(Componente arr[], int n, long *comparacoes) {
+    ordenarPorIndice(arr, n, comparacoes, compararNome, 1);
+}
+
+void mergeSortTipo(Componente arr[], int n, long *comparacoes) {
+    ordenarPorIndice(arr, n, comparacoes, compararTipo, 1);
+}
+
+void mergeSortPrioridade(Componente arr[], int n, long *comparacoes) {
+    ordenarPorIndice(arr, n, comparacoes, compararPrioridade, 1);
+}
+
+// -----------------------------
+// Merge Sort paralelo (../comum/paralelo.h): mesma ordem do Merge Sort
+// estável, com threadsOrdenacao threads do pool. Abaixo de PARALELO_MINIMO
+// componentes roda o serial.
+// -----------------------------
+int threadsOrdenacao = 0; // 0: um por núcleo disponível
+
+int threadsEmUso(void) {
+    return threadsOrdenacao > 0 ? threadsOrdenacao : paralelo_threadsDisponiveis();
+}
+
+void ordenarPorIndiceParalelo(Componente arr[], int n, long *comparacoes, Comparador cmp) {
+    *comparacoes = 0;
+    if (n < 2) return;
+    int threads = threadsEmUso();
+    int *perm = (int *)ordenacao_alocar((size_t)n * sizeof(int));
+    Medicao m = medicao_iniciar();
+    ordenacao_identidade(perm, n);
+    *comparacoes = paralelo_mergesort(&paralelo_pool, arr, sizeof(Componente), perm, n, cmp, threads);
+    medicao_registrar(&m, &estatisticas[EST_FASE_INDICES]);
+
+    m = medicao_iniciar();
+    paralelo_aplicarPermutacao(&paralelo_pool, arr, sizeof(Componente), perm, n, threads);
+    medicao_registrar(&m, &estatisticas[EST_FASE_PERMUTACAO]);
+    free(perm);
+}
+
+void mergeSortParaleloNome(Componente arr[], int n, long *comparacoes) {
+    ordenarPorIndiceParalelo(arr, n, comparacoes, compararNome);
+}
+
+void mergeSortParaleloTipo(Componente arr[], int n, long *comparacoes) {
+    ordenarPorIndiceParalelo(arr, n, comparacoes, compararTipo);
+}
+
+void mergeSortParaleloPrioridade(Componente arr[], int n, long *comparacoes) {
+    ordenarPorIndiceParalelo(arr, n, comparacoes, compararPrioridade);
+}
+
+// -----------------------------
+// Ordenações lineares (sem comparações) por chave inteira.
+// Em 'comparacoes' devolvem as movimentações de componentes; as passagens
+// sobre os dados ficam em passesOrdenacao.
+// -----------------------------
+int passesOrdenacao = 0;
+
+int chavePrioridade(const void *c) {
+    return ((const Componente *)c)->prioridade;
+}
+
+int chaveQuantidade(const void *c) {
+    return ((const Componente *)c)->quantidade;
+}
+
+int chaveTipo(const void *c) {
+    return ordemTipo(((const Componente *)c)->tipo);
+}
+
+// Counting sort por prioridade: O(n + k) com k = faixa de prioridades (10)
+void countingSortPrioridade(Componente arr[], int n, long *comparacoes) {
+    *comparacoes = ordenacao_contagem(arr, sizeof(Componente), n, chavePrioridade, &passesOrdenacao);
+}
+
+// Radix sort LSD (base 256) por quantidade: no máximo 4 passagens de distribuição
+void radixSortQuantidade(Componente arr[], int n, long *comparacoes) {
+    *comparacoes = ordenacao_radix(arr, sizeof(Componente), n, chaveQuantidade, &passesOrdenacao);
+}
+
+// Counting sort por tipo: a chave é a posição alfabética do id (k = tipos distintos)
+void countingSortTipo(Componente arr[], int n, long *comparacoes) {
+    *comparacoes = ordenacao_contagem(arr, sizeof(Componente), n, chaveTipo, &passesOrdenacao);
+}
+
+// -----------------------------
+// Ordenação por vários critérios, como (tipo, prioridade decrescente, nome).
+// Cada componente é codificado uma vez numa chave normalizada
+// (../comum/chavenormal.h) e a ordenação só compara chaves com memcmp. O
+// comparador encadeado, campo a campo, fica como referência.
+// -----------------------------
+#define MAX_CRITERIOS 4
+
+typedef struct {
+    CriterioOrdenacao criterio;
+    int decrescente;
+} CampoOrdem;
+
+typedef struct {
+    CampoOrdem campos[MAX_CRITERIOS];
+    int num;
+} OrdemComposta;
+
+// Ordem usada pelas funções abaixo (assinatura de SortFunc, sem contexto)
+OrdemComposta ordemComposta;
+
+// Lê uma ordem como "tipo,-prioridade,nome": campos separados por vírgula
+// (nome, tipo, prioridade, quantidade ou só a inicial), '-' na frente para
+// decrescente. Retorna 0 se o texto não é válido.
+int interpretarOrdem(const char *texto, OrdemComposta *o) {
+    static const char *nomes[] = { "nome", "tipo", "prioridade", "quantidade" };
+    o->num = 0;
+    while (*texto) {
+        const char *fim = strchr(texto, ',');
+        size_t len = fim != NULL ? (size_t)(fim - texto) : strlen(texto);
+        int decrescente = 0;
+        if (len > 0 && (*texto == '-' || *texto == '+')) {
+            decrescente = *texto == '-';
+            texto++;
+            len--;
+        }
+        int campo = -1;
+        for (int c = 0; c < 4 && len > 0; c++)
+            if ((len == 1 || len == strlen(nomes[c])) && strncmp(texto, nomes[c], len) == 0) campo = c;
+        if (campo < 0 || o->num == MAX_CRITERIOS) return 0;
+        o->campos[o->num].criterio = (CriterioOrdenacao)campo;
+        o->campos[o->num].decrescente = decrescente;
+        o->num++;
+        texto += len;
+        if (*texto == ',') texto++;
+    }
+    return o->num > 0;
+}
+
+// Bytes de cada campo na chave: o nome sempre tem o '\0' dentro de STRLEN
+size_t larguraCampo(CriterioOrdenacao criterio) {
+    switch (criterio) {
+    case CRITERIO_NOME: return STRLEN - 1;
+    case CRITERIO_TIPO: return 2;
+    default: return 4;
+    }
+}
+
+size_t larguraChave(const OrdemComposta *o) {
+    size_t largura = 0;
+    for (int i = 0; i < o->num; i++) largura += larguraCampo(o->campos[i].criterio);
+    return largura;
+}
+
+void codificarComponente(const Componente *c, const OrdemComposta *o, unsigned char *p) {
+    for (int i = 0; i < o->num; i++) {
+        int d = o->campos[i].decrescente;
+        switch (o->campos[i].criterio) {
+        case CRITERIO_NOME: p = chavenormal_texto(p, c->nome, STRLEN - 1, d); break;
+        case CRITERIO_TIPO: p = chavenormal_natural16(p, (unsigned)ordemTipo(c->tipo), d); break;
+        case CRITERIO_PRIORIDADE: p = chavenormal_inteiro(p, c->prioridade, d); break;
+        case CRITERIO_QUANTIDADE: p = chavenormal_inteiro(p, c->quantidade, d); break;
+        }
+    }
+}
+
+// Merge Sort estável sobre as chaves normalizadas; a codificação entra na
+// fase de ordenar índices
+void ordenarChaveComposta(Componente arr[], int n, long *comparacoes) {
+    *comparacoes = 0;
+    if (n < 2) return;
+    size_t largura = larguraChave(&ordemComposta);
+    unsigned char *chaves = (unsigned char *)ordenacao_alocar((size_t)n * largura);
+    int *perm = (int *)ordenacao_alocar((size_t)n * sizeof(int));
+    Medicao m = medicao_iniciar();
+    for (int i = 0; i < n; i++) codificarComponente(&arr[i], &ordemComposta, chaves + (size_t)i * largura);
+    ordenacao_identidade(perm, n);
+    *comparacoes = chavenormal_ordenar(chaves, largura, perm, n);
+    medicao_registrar(&m, &estatisticas[EST_FASE_INDICES]);
+
+    m = medicao_iniciar();
+    ordenacao_aplicarPermutacao(arr, sizeof(Componente), perm, n);
+    medicao_registrar(&m, &estatisticas[EST_FASE_PERMUTACAO]);
+    free(perm);
+    free(chaves);
+}
+
+// Referência: a mesma ordem avaliada campo a campo a cada comparação
+int compararComposto(const void *a, const void *b) {
+    const Componente *x = (const Componente *)a, *y = (const Componente *)b;
+    for (int i = 0; i < ordemComposta.num; i++) {
+        int c = 0;
+        switch (ordemComposta.campos[i].criterio) {
+        case CRITERIO_NOME: c = chave_comparar(x->nome, y->nome, STRLEN); break;
+        case CRITERIO_TIPO: c = compararTipo(x, y); break;
+        case CRITERIO_PRIORIDADE: c = compararPrioridade(x, y); break;
+        case CRITERIO_QUANTIDADE: c = (x->quantidade > y->quantidade) - (x->quantidade < y->quantidade); break;
+        }
+        if (c != 0) return ordemComposta.campos[i].decrescente ? -c : c;
+    }
+    return 0;
+}
+
+void mergeSortComposto(Componente arr[], int n, long *comparacoes) {
+    ordenarPorIndice(arr, n, comparacoes, compararComposto, 1);
+}
+
+// A busca binária por nome continua valendo se o nome crescente vem primeiro
+int ordemComecaPorNome(const OrdemComposta *o) {
+    return o->num > 0 && o->campos[0].criterio == CRITERIO_NOME && !o->campos[0].decrescente;
+}
+
 // -----------------------------
 // Medidor de tempo para algoritmos de ordenação
 // SortFunc: ponteiro para função de ordenação com assinatura (Componente[], int, long*)
-// Retorna tempo em segundos; comparacoes é preenchido pela função de ordenação.
+// Retorna o tempo de parede em nanossegundos (relógio monotônico) e registra
+// a amostra nas estatísticas; comparacoes é preenchido pela função de ordenação.
 // -----------------------------
 typedef void (*SortFunc)(Componente[], int, long*);
 
-double medirTempo(SortFunc alg, Componente arr[], int n, long *comparacoes) {
-    clock_t inicio = clock();
+long long medirTempo(SortFunc alg, Componente arr[], int n, long *comparacoes) {
+    long long inicio = cronometro_agoraNs();
+    unsigned long long ciclos = cronometro_ciclos();
     alg(arr, n, comparacoes);
-    clock_t fim = clock();
-    return (double)(fim - inicio) / (double)CLOCKS_PER_SEC;
+    long long ns = cronometro_agoraNs() - inicio;
+    histograma_registrar(&estatisticas[EST_ORDENACAO], ns, cronometro_ciclos() - ciclos);
+    return ns;
+}
+
+// -----------------------------
+// Tabela de algoritmos: os três quadráticos (linha de base) e os O(n log n).
+// A opção 7 compara todos; a opção 8 ordena o inventário com um deles.
+// -----------------------------
+typedef struct {
+    const char *nome;
+    SortFunc alg;
+    CriterioOrdenacao criterio;
+    const char *medida; // o que é contado em 'comparacoes'
+    int linear;         // 1: também informa passesOrdenacao
+} AlgoritmoOrdenacao;
+
+const AlgoritmoOrdenacao algoritmos[] = {
+    { "Bubble Sort (nome)",            bubbleSortNome,          CRITERIO_NOME,       "Comparações(strcmp)", 0 },
+    { "Insertion Sort (tipo)",         insertionSortTipo,       CRITERIO_TIPO,       "Comparações(int)", 0 },
+    { "Selection Sort (prioridade)",   selectionSortPrioridade, CRITERIO_PRIORIDADE, "Comparações(int)", 0 },
+    { "Introsort (nome)",              introSortNome,           CRITERIO_NOME,       "Comparações(strcmp)", 0 },
+    { "Introsort (tipo)",              introSortTipo,           CRITERIO_TIPO,       "Comparações(int)", 0 },
+    { "Introsort (prioridade)",        introSortPrioridade,     CRITERIO_PRIORIDADE, "Comparações(int)", 0 },
+    { "Merge Sort estável (nome)",     mergeSortNome,           CRITERIO_NOME,       "Comparações(strcmp)", 0 },
+    { "Merge Sort estável (tipo)",     mergeSortTipo,           CRITERIO_TIPO,       "Comparações(int)", 0 },
+    { "Merge Sort estável (prioridade)", mergeSortPrioridade,   CRITERIO_PRIORIDADE, "Comparações(int)", 0 },
+    { "Counting Sort (prioridade)",    countingSortPrioridade,  CRITERIO_PRIORIDADE, "Movimentações", 1 },
+    { "Radix Sort LSD (quantidade)",   radixSortQuantidade,     CRITERIO_QUANTIDADE, "Movimentações", 1 },
+    { "Counting Sort (tipo)",          countingSortTipo,        CRITERIO_TIPO,       "Movimentações", 1 },
+    { "Merge Sort paralelo (nome)",    mergeSortParaleloNome,   CRITERIO_NOME,       "Comparações(strcmp)", 0 },
+    { "Merge Sort paralelo (tipo)",    mergeSortParaleloTipo,   CRITERIO_TIPO,       "Comparações(int)", 0 },
+    { "Merge Sort paralelo (prioridade)", mergeSortParaleloPrioridade, CRITERIO_PRIORIDADE, "Comparações(int)", 0 },
+};
+const int NUM_ALGORITMOS = (int)(sizeof(algoritmos) / sizeof(algoritmos[0]));
+#define NUM_BASELINE 3 // os três primeiros são os algoritmos originais
+
+// -----------------------------
+// Comparação simultânea (opção 7): cada algoritmo roda na sua própria
+// thread, presa a um núcleo, sobre a sua cópia dos dados. O conjunto leva
+// o tempo do mais lento, não a soma. Cada thread mede o próprio tempo; as
+// amostras entram no histograma depois, na thread principal.
+// Só para algoritmos sem estado global (os da linha de base).
+// -----------------------------
+typedef struct {
+    SortFunc alg;
+    Componente *dados;           // cópia própria
+    int n;
+    long comparacoes;
+    long long ns;                // tempo do algoritmo na sua thread
+    unsigned long long ciclos;
+    int cpu;                     // núcleo em que terminou (-1: desconhecido)
+} ExecucaoSimultanea;
+
+void rodarExecucaoSimultanea(void *arg) {
+    ExecucaoSimultanea *e = (ExecucaoSimultanea *)arg;
+    long long inicio = cronometro_agoraNs();
+    unsigned long long ciclos = cronometro_ciclos();
+    e->alg(e->dados, e->n, &e->comparacoes);
+    e->ns = cronometro_agoraNs() - inicio;
+    e->ciclos = cronometro_ciclos() - ciclos;
+    e->cpu = paralelo_cpuAtual();
+}
+
+// Roda as execuções ao mesmo tempo; devolve o tempo de parede do conjunto
+long long medirTempoSimultaneo(ExecucaoSimultanea exec[], int k) {
+    long long inicio = cronometro_agoraNs();
+    paralelo_simultaneas(rodarExecucaoSimultanea, exec, sizeof(ExecucaoSimultanea), k);
+    long long parede = cronometro_agoraNs() - inicio;
+    for (int i = 0; i < k; i++) histograma_registrar(&estatisticas[EST_ORDENACAO], exec[i].ns, exec[i].ciclos);
+    return parede;
+}
+
+// -----------------------------
+// Layout colunar (struct-of-arrays): um vetor contíguo por campo, todos na
+// mesma ordem. Ordenar ou varrer por prioridade/quantidade lê 4 bytes por
+// componente em vez do Componente inteiro; nomes e tipos só são tocados
+// quando o critério é textual ou no reposicionamento final.
+// As colunas não são a fonte dos dados: são transpostas do inventário
+// antes de cada ordenação (carregarColunas) e, se a ordem obtida deve
+// valer, copiadas de volta (exportarColunas). Inserções e remoções só
+// mexem no inventário.
+// -----------------------------
+typedef struct {
+    char (*nome)[STRLEN];
+    uint16_t *tipo;
+    int *prioridade;
+    int *quantidade;
+    int tamanho;
+    int capacidade;
+} ColunasComponentes;
+
+void iniciarColunas(ColunasComponentes *c) {
+    memset(c, 0, sizeof(*c));
+}
+
+void liberarColunas(ColunasComponentes *c) {
+    free(c->nome);
+    free(c->tipo);
+    free(c->prioridade);
+    free(c->quantidade);
+    iniciarColunas(c);
+}
+
+// Transpõe n componentes para as colunas (reaproveita a memória se couber)
+void carregarColunas(ColunasComponentes *c, const Componente arr[], int n) {
+    if (n > c->capacidade) {
+        liberarColunas(c);
+        c->nome = ordenacao_alocar((size_t)n * STRLEN);
+        c->tipo = ordenacao_alocar((size_t)n * sizeof(uint16_t));
+        c->prioridade = ordenacao_alocar((size_t)n * sizeof(int));
+        c->quantidade = ordenacao_alocar((size_t)n * sizeof(int));
+        c->capacidade = n;
+    }
+    for (int i = 0; i < n; i++) {
+        memcpy(c->nome[i], arr[i].nome, STRLEN);
+        c->tipo[i] = arr[i].tipo;
+        c->prioridade[i] = arr[i].prioridade;
+        c->quantidade[i] = arr[i].quantidade;
+    }
+    c->tamanho = n;
+}
+
+// Caminho inverso: reescreve o vetor de componentes a partir das colunas
+void exportarColunas(const ColunasComponentes *c, Componente arr[]) {
+    for (int i = 0; i < c->tamanho; i++) {
+        memcpy(arr[i].nome, c->nome[i], STRLEN);
+        arr[i].tipo = c->tipo[i];
+        arr[i].prioridade = c->prioridade[i];
+        arr[i].quantidade = c->quantidade[i];
+    }
+}
+
+void mostrarColunas(const ColunasComponentes *c, int limite) {
+    if (!imprimirCabecalhoComponentes(c->tamanho)) return;
+    int exibir = limite > 0 && limite < c->tamanho ? limite : c->tamanho;
+    for (int i = 0; i < exibir; i++) {
+        imprimirLinhaComponente(i, c->nome[i], textoTipo(c->tipo[i]), c->prioridade[i], c->quantidade[i]);
+    }
+    fecharTabelaComponentes(exibir, c->tamanho);
+}
+
+// Comparadores sobre uma coluna (o tamanho do elemento vem de quem ordena)
+int compararNomeColuna(const void *a, const void *b) {
+    return chave_comparar((const char *)a, (const char *)b, STRLEN);
+}
+
+int compararTipoColuna(const void *a, const void *b) {
+    int ta = ordemTipo(*(const uint16_t *)a), tb = ordemTipo(*(const uint16_t *)b);
+    return (ta > tb) - (ta < tb);
+}
+
+int compararInteiroColuna(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Reposiciona as quatro colunas segundo perm (cada uma é copiada uma vez)
+void reordenarColunas(ColunasComponentes *c, const int *perm) {
+    Medicao m = medicao_iniciar();
+    ordenacao_aplicarPermutacao(c->nome, STRLEN, perm, c->tamanho);
+    ordenacao_aplicarPermutacao(c->tipo, sizeof(uint16_t), perm, c->tamanho);
+    ordenacao_aplicarPermutacao(c->prioridade, sizeof(int), perm, c->tamanho);
+    ordenacao_aplicarPermutacao(c->quantidade, sizeof(int), perm, c->tamanho);
+    medicao_registrar(&m, &estatisticas[EST_FASE_PERMUTACAO]);
+}
+
+// Ordena pela coluna 'chave' (tamElem bytes por componente)
+void ordenarColunasPor(ColunasComponentes *c, const void *chave, size_t tamElem, Comparador cmp,
+                       int estavel, long *comparacoes) {
+    *comparacoes = 0;
+    int n = c->tamanho;
+    if (n < 2) return;
+    int *perm = (int *)ordenacao_alocar((size_t)n * sizeof(int));
+    Medicao m = medicao_iniciar();
+    ordenacao_identidade(perm, n);
+    if (estavel) *comparacoes = ordenacao_mergesort(chave, tamElem, perm, n, cmp);
+    else *comparacoes = ordenacao_introsort(chave, tamElem, perm, n, cmp);
+    medicao_registrar(&m, &estatisticas[EST_FASE_INDICES]);
+    reordenarColunas(c, perm);
+    free(perm);
+}
+
+void introSortNomeColunas(ColunasComponentes *c, long *comparacoes) {
+    ordenarColunasPor(c, c->nome, STRLEN, compararNomeColuna, 0, comparacoes);
+}
+
+void introSortPrioridadeColunas(ColunasComponentes *c, long *comparacoes) {
+    ordenarColunasPor(c, c->prioridade, sizeof(int), compararInteiroColuna, 0, comparacoes);
+}
+
+void mergeSortNomeColunas(ColunasComponentes *c, long *comparacoes) {
+    ordenarColunasPor(c, c->nome, STRLEN, compararNomeColuna, 1, comparacoes);
+}
+
+void mergeSortTipoColunas(ColunasComponentes *c, long *comparacoes) {
+    ordenarColunasPor(c, c->tipo, sizeof(uint16_t), compararTipoColuna, 1, comparacoes);
+}
+
+void mergeSortPrioridadeColunas(ColunasComponentes *c, long *comparacoes) {
+    ordenarColunasPor(c, c->prioridade, sizeof(int), compararInteiroColuna, 1, comparacoes);
+}
+
+// Lineares: a permutação sai só da coluna de chaves
+void countingSortPrioridadeColunas(ColunasComponentes *c, long *comparacoes) {
+    int *perm = (int *)ordenacao_alocar((size_t)c->tamanho * sizeof(int));
+    *comparacoes = ordenacao_contagemColuna(c->prioridade, c->tamanho, perm, &passesOrdenacao);
+    if (*comparacoes > 0) reordenarColunas(c, perm);
+    free(perm);
+}
+
+void radixSortQuantidadeColunas(ColunasComponentes *c, long *comparacoes) {
+    int *perm = (int *)ordenacao_alocar((size_t)c->tamanho * sizeof(int));
+    *comparacoes = ordenacao_radixColuna(c->quantidade, c->tamanho, perm, &passesOrdenacao);
+    if (*comparacoes > 0) reordenarColunas(c, perm);
+    free(perm);
+}
+
+// A coluna de tipos guarda ids; a chave da contagem é a posição alfabética
+void countingSortTipoColunas(ColunasComponentes *c, long *comparacoes) {
+    int *chaves = (int *)ordenacao_alocar((size_t)c->tamanho * sizeof(int));
+    int *perm = (int *)ordenacao_alocar((size_t)c->tamanho * sizeof(int));
+    for (int i = 0; i < c->tamanho; i++) chaves[i] = ordemTipo(c->tipo[i]);
+    *comparacoes = ordenacao_contagemColuna(chaves, c->tamanho, perm, &passesOrdenacao);
+    if (*comparacoes > 0) reordenarColunas(c, perm);
+    free(chaves);
+    free(perm);
+}
+
+typedef void (*SortFuncColunas)(ColunasComponentes *, long *);
+
+// Mede a ordenação colunar de ponta a ponta: transpõe arr para as colunas,
+// ordena e, se 'exportar', reescreve arr na ordem obtida. Sem contar as
+// cópias a comparação com os algoritmos sobre o vetor seria injusta.
+long long medirTempoColunas(SortFuncColunas alg, ColunasComponentes *c, Componente arr[], int n, int exportar,
+                            long *comparacoes) {
+    long long inicio = cronometro_agoraNs();
+    unsigned long long ciclos = cronometro_ciclos();
+    carregarColunas(c, arr, n);
+    alg(c, comparacoes);
+    if (exportar) exportarColunas(c, arr);
+    long long ns = cronometro_agoraNs() - inicio;
+    histograma_registrar(&estatisticas[EST_ORDENACAO], ns, cronometro_ciclos() - ciclos);
+    return ns;
+}
+
+typedef struct {
+    const char *nome;
+    SortFuncColunas alg;
+    CriterioOrdenacao criterio;
+    const char *medida;
+    int linear;
+} AlgoritmoColunar;
+
+const AlgoritmoColunar algoritmosColunas[] = {
+    { "Introsort colunar (nome)",         introSortNomeColunas,          CRITERIO_NOME,       "Comparações(strcmp)", 0 },
+    { "Introsort colunar (prioridade)",   introSortPrioridadeColunas,    CRITERIO_PRIORIDADE, "Comparações(int)", 0 },
+    { "Merge Sort colunar (nome)",        mergeSortNomeColunas,          CRITERIO_NOME,       "Comparações(strcmp)", 0 },
+    { "Merge Sort colunar (tipo)",        mergeSortTipoColunas,          CRITERIO_TIPO,       "Comparações(int)", 0 },
+    { "Merge Sort colunar (prioridade)",  mergeSortPrioridadeColunas,    CRITERIO_PRIORIDADE, "Comparações(int)", 0 },
+    { "Counting Sort colunar (prioridade)", countingSortPrioridadeColunas, CRITERIO_PRIORIDADE, "Movimentações(índices)", 1 },
+    { "Radix Sort colunar (quantidade)",  radixSortQuantidadeColunas,    CRITERIO_QUANTIDADE, "Movimentações(índices)", 1 },
+    { "Counting Sort colunar (tipo)",     countingSortTipoColunas,       CRITERIO_TIPO,       "Movimentações(índices)", 1 },
+};
+const int NUM_ALGORITMOS_COLUNAS = (int)(sizeof(algoritmosColunas) / sizeof(algoritmosColunas[0]));
+
+// Busca binária na coluna de nomes (exige colunas ordenadas por nome)
+int buscaBinariaColunas(const ColunasComponentes *c, const char *nome, long *comparacoes) {
+    Medicao m = medicao_iniciar();
+    int inicio = 0, fim = c->tamanho - 1, achou = -1;
+    ChaveBusca k;
+    chave_preparar(&k, nome, STRLEN);
+    *comparacoes = 0;
+    while (inicio <= fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        (*comparacoes)++;
+        int cmp = chave_comparar(c->nome[meio], k.texto, STRLEN);
+        if (cmp == 0) { achou = meio; break; }
+        else if (cmp < 0) inicio = meio + 1;
+        else fim = meio - 1;
+    }
+    medicao_registrar(&m, &estatisticas[EST_BUSCA_BINARIA]);
+    return achou;
 }
 
 // -----------------------------
@@ -162,17 +845,32 @@ double medirTempo(SortFunc alg, Componente arr[], int n, long *comparacoes) {
 // Retorna índice ou -1.
 // -----------------------------
 int buscaBinariaPorNome(Componente arr[], int n, const char *nome, long *comparacoes) {
-    int inicio = 0, fim = n - 1;
+    Medicao m = medicao_iniciar();
+    int inicio = 0, fim = n - 1, achou = -1;
+    ChaveBusca k; // completada com zeros: comparada campo a campo em blocos
+    chave_preparar(&k, nome, STRLEN);
     *comparacoes = 0;
     while (inicio <= fim) {
         int meio = inicio + (fim - inicio) / 2;
         (*comparacoes)++;
-        int cmp = strcmp(arr[meio].nome, nome);
-        if (cmp == 0) return meio;
+        int cmp = chave_comparar(arr[meio].nome, k.texto, STRLEN);
+        if (cmp == 0) { achou = meio; break; }
         else if (cmp < 0) inicio = meio + 1;
         else fim = meio - 1;
     }
-    return -1;
+    medicao_registrar(&m, &estatisticas[EST_BUSCA_BINARIA]);
+    return achou;
+}
+
+// Autocompletar: no vetor ordenado por nome, os nomes que começam com
+// 'prefixo' formam uma faixa contígua. Devolve quantos são (o primeiro em
+// *inicio) com duas buscas binárias; listar custa só os encontrados.
+int buscaPrefixoPorNome(Componente arr[], int n, const char *prefixo, int *inicio, long *comparacoes) {
+    Medicao m = medicao_iniciar();
+    int total = chave_faixaPrefixo(n > 0 ? arr[0].nome : NULL, sizeof(Componente), n, STRLEN, prefixo, inicio,
+                                   comparacoes);
+    medicao_registrar(&m, &estatisticas[EST_BUSCA_PREFIXO]);
+    return total;
 }
 
 // -----------------------------
@@ -182,36 +880,778 @@ void copiarVetor(Componente dest[], Componente src[], int n) {
     for (int i = 0; i < n; i++) dest[i] = src[i];
 }
 
+// Merge Sort paralelo com 1, 2, 4... threads até as em uso, sobre cópias
+// dos mesmos dados; o speedup é relativo à execução com uma thread
+void mostrarSpeedupParalelo(Componente componentes[], int n) {
+    const SortFunc criterios[3] = { mergeSortParaleloNome, mergeSortParaleloTipo, mergeSortParaleloPrioridade };
+    if (n < PARALELO_MINIMO) {
+        printf("\n(Merge Sort paralelo: abaixo de %d componentes ele roda serial.)\n", PARALELO_MINIMO);
+        return;
+    }
+    Componente *copia = malloc((size_t)n * sizeof(Componente));
+    if (copia == NULL) return;
+
+    int salvo = threadsOrdenacao;
+    int maximo = threadsEmUso();
+    long long umaThread[3] = { 0, 0, 0 };
+    printf("\n--- Merge Sort paralelo: speedup por número de threads (%d núcleos) ---\n",
+           paralelo_threadsDisponiveis());
+    printf("%-8s | %-22s | %-22s | %-22s\n", "Threads", "nome", "tipo", "prioridade");
+    for (int t = 1; t <= maximo; t = (t < maximo && t * 2 > maximo) ? maximo : t * 2) {
+        threadsOrdenacao = t;
+        printf("%-8d", t);
+        for (int k = 0; k < 3; k++) {
+            long c = 0;
+            copiarVetor(copia, componentes, n);
+            long long ns = medirTempo(criterios[k], copia, n, &c);
+            if (t == 1) umaThread[k] = ns;
+            printf(" | %-12s %6.2fx  ", cronometro_texto(ns), ns > 0 ? (double)umaThread[k] / (double)ns : 0.0);
+        }
+        printf("\n");
+    }
+    threadsOrdenacao = salvo;
+    free(copia);
+}
+
+// -----------------------------
+// Estoque: o vetor de componentes (a ordem que os menus mostram e ordenam)
+// e duas árvores B com cópias deles, por nome e por prioridade. As árvores
+// acompanham cada cadastro e remoção e não dependem da ordem do vetor.
+// Os baldes por tipo seguem a mesma ideia: porTipo[id] guarda cópias dos
+// componentes daquele tipo, e listar um tipo não varre o vetor.
+// A fila de montagem é mais uma cópia, num heap: o topo é o próximo
+// componente a montar.
+// -----------------------------
+typedef struct {
+    Arena arena;
+    Inventario componentes;
+    ArvoreB porNome;
+    ArvoreB porPrioridade;
+    int arvoresProntas; // 0 após carregar um snapshot: montadas no primeiro uso
+    Arena arenaBaldes;  // memória dos baldes (descartada ao refazê-los)
+    Inventario *porTipo;
+    int numBaldes;
+    int baldesProntos;  // como arvoresProntas
+    FilaPrioridade filaMontagem;
+    int filaPronta;     // como arvoresProntas
+    Snapshot snapshot;  // região mapeada para onde 'componentes' pode apontar
+} Estoque;
+
+// Ordem total exigida pelas árvores: nome, tipo, prioridade, quantidade
+int compararComponenteCompleto(const void *a, const void *b) {
+    const Componente *x = (const Componente *)a, *y = (const Componente *)b;
+    int c = chave_comparar(x->nome, y->nome, STRLEN);
+    if (c == 0) c = compararTipo(x, y);
+    if (c == 0) c = (x->prioridade > y->prioridade) - (x->prioridade < y->prioridade);
+    if (c == 0) c = (x->quantidade > y->quantidade) - (x->quantidade < y->quantidade);
+    return c;
+}
+
+// Prioridade primeiro, depois a ordem completa
+int compararComponentePrioridade(const void *a, const void *b) {
+    int c = compararPrioridade(a, b);
+    return c ? c : compararComponenteCompleto(a, b);
+}
+
+// Ordem da fila de montagem: maior prioridade primeiro; no empate, o
+// menor na ordem completa (nome antes), para a ordem de saída ser fixa
+int compararMontagem(const void *a, const void *b) {
+    int c = compararPrioridade(a, b);
+    return c ? c : compararComponenteCompleto(b, a);
+}
+
+void iniciarEstoque(Estoque *e) {
+    arena_iniciar(&e->arena);
+    inventario_iniciar(&e->componentes, &e->arena, sizeof(Componente));
+    arvoreb_iniciar(&e->porNome, sizeof(Componente), compararComponenteCompleto);
+    arvoreb_iniciar(&e->porPrioridade, sizeof(Componente), compararComponentePrioridade);
+    e->arvoresProntas = 1;
+    arena_iniciar(&e->arenaBaldes);
+    e->porTipo = NULL;
+    e->numBaldes = 0;
+    e->baldesProntos = 1;
+    heap_iniciar(&e->filaMontagem, sizeof(Componente), offsetof(Componente, nome), compararMontagem);
+    e->filaPronta = 1;
+    snapshot_iniciar(&e->snapshot);
+}
+
+// Esvazia os baldes por tipo; ficam para ser refeitos no primeiro uso
+void descartarBaldes(Estoque *e) {
+    arena_liberar(&e->arenaBaldes);
+    arena_iniciar(&e->arenaBaldes);
+    free(e->porTipo);
+    e->porTipo = NULL;
+    e->numBaldes = 0;
+    e->baldesProntos = 0;
+}
+
+void liberarEstoque(Estoque *e) {
+    arvoreb_liberar(&e->porNome);
+    arvoreb_liberar(&e->porPrioridade);
+    descartarBaldes(e);
+    heap_liberar(&e->filaMontagem);
+    arena_liberar(&e->arena);
+    snapshot_liberar(&e->snapshot);
+}
+
+// Balde do tipo 'id', criando os que faltam até ele
+Inventario *baldeTipo(Estoque *e, int id) {
+    if (id >= e->numBaldes) {
+        Inventario *novos = (Inventario *)realloc(e->porTipo, (size_t)(id + 1) * sizeof(Inventario));
+        if (novos == NULL) {
+            fprintf(stderr, "Memória insuficiente (baldes por tipo).\n");
+            exit(1);
+        }
+        e->porTipo = novos;
+        for (int t = e->numBaldes; t <= id; t++)
+            inventario_iniciar(&e->porTipo[t], &e->arenaBaldes, sizeof(Componente));
+        e->numBaldes = id + 1;
+    }
+    return &e->porTipo[id];
+}
+
+// Monta os baldes a partir do vetor, se ainda não estiverem prontos
+void garantirBaldes(Estoque *e) {
+    if (e->baldesProntos) return;
+    const Componente *arr = (const Componente *)e->componentes.dados;
+    for (int i = 0; i < e->componentes.tamanho; i++)
+        *(Componente *)inventario_anexar(baldeTipo(e, arr[i].tipo)) = arr[i];
+    e->baldesProntos = 1;
+}
+
+// Monta as árvores a partir do vetor, se ainda não estiverem prontas
+void garantirArvores(Estoque *e) {
+    if (e->arvoresProntas) return;
+    const Componente *arr = (const Componente *)e->componentes.dados;
+    for (int i = 0; i < e->componentes.tamanho; i++) {
+        arvoreb_inserir(&e->porNome, &arr[i]);
+        arvoreb_inserir(&e->porPrioridade, &arr[i]);
+    }
+    e->arvoresProntas = 1;
+}
+
+// Monta a fila de montagem a partir do vetor (O(n)), se ainda não estiver pronta
+void garantirFila(Estoque *e) {
+    if (e->filaPronta) return;
+    heap_montar(&e->filaMontagem, e->componentes.dados, e->componentes.tamanho);
+    e->filaPronta = 1;
+}
+
+// -----------------------------
+// Snapshot: o vetor de componentes como está na memória
+// -----------------------------
+// O dicionário de tipos vai no anexo: os componentes só guardam ids
+int salvarEstoque(Estoque *e, const char *caminho, int ordenadoPorNome) {
+    return snapshot_gravarComAnexo(caminho, "COMPON", e->componentes.dados, sizeof(Componente),
+                                   e->componentes.tamanho, ordenadoPorNome ? SNAPSHOT_ORDENADO_NOME : 0, 0,
+                                   tiposComponentes.textos,
+                                   (size_t)tiposComponentes.quantidade * DICIONARIO_TEXTO);
+}
+
+// Substitui o estoque pelo snapshot. Os componentes passam a ser lidos
+// direto da região mapeada; as árvores e os baldes ficam para o primeiro uso.
+int carregarEstoque(Estoque *e, const char *caminho, int *ordenadoPorNome) {
+    Snapshot novo;
+    if (!snapshot_carregar(&novo, caminho, "COMPON", sizeof(Componente))) return 0;
+    Dicionario tipos;
+    dicionario_iniciar(&tipos);
+    if (novo.tamAnexo % DICIONARIO_TEXTO != 0 ||
+        !dicionario_carregar(&tipos, novo.anexo, (int)(novo.tamAnexo / DICIONARIO_TEXTO))) {
+        fprintf(stderr, "Snapshot '%s' inválido: dicionário de tipos corrompido.\n", caminho);
+        dicionario_liberar(&tipos);
+        snapshot_liberar(&novo);
+        return 0;
+    }
+    dicionario_liberar(&tiposComponentes);
+    tiposComponentes = tipos;
+    arvoreb_liberar(&e->porNome);
+    arvoreb_liberar(&e->porPrioridade);
+    e->arvoresProntas = 0;
+    descartarBaldes(e);
+    e->filaPronta = 0;
+    inventario_adotar(&e->componentes, novo.registros, novo.quantidade);
+    snapshot_liberar(&e->snapshot); // o vetor anterior não é mais referenciado
+    e->snapshot = novo;
+    *ordenadoPorNome = (novo.flags & SNAPSHOT_ORDENADO_NOME) != 0;
+    return 1;
+}
+
+// Sonda para as árvores: o texto dado e os demais campos no extremo
+// inferior (maximo = 0) ou superior (maximo = 1). No extremo superior, o
+// nome é completado com 0xFF para cobrir tudo que começa com 'nome'.
+void montarSonda(Componente *s, const char *nome, int prioridade, int maximo) {
+    memset(s, maximo ? 0xFF : 0, sizeof(*s));
+    size_t len = strlen(nome);
+    if (len > STRLEN - 1) len = STRLEN - 1;
+    memcpy(s->nome, nome, len);
+    if (!maximo) s->nome[len] = '\0';
+    s->nome[STRLEN - 1] = '\0';
+    s->tipo = maximo ? DICIONARIO_DEPOIS : DICIONARIO_ANTES;
+    s->prioridade = prioridade;
+    s->quantidade = maximo ? INT_MAX : INT_MIN;
+}
+
+// -----------------------------
+// Cadastro: anexa um componente ao estoque (sem entrada/saída)
+// -----------------------------
+void adicionarComponente(Estoque *estoque, const Componente *c) {
+    Medicao m = medicao_iniciar();
+    *(Componente *)inventario_anexar(&estoque->componentes) = *c;
+    if (estoque->arvoresProntas) {
+        arvoreb_inserir(&estoque->porNome, c);
+        arvoreb_inserir(&estoque->porPrioridade, c);
+    }
+    if (estoque->baldesProntos) *(Componente *)inventario_anexar(baldeTipo(estoque, c->tipo)) = *c;
+    if (estoque->filaPronta) heap_inserir(&estoque->filaMontagem, c);
+    medicao_registrar(&m, &estatisticas[EST_CADASTRO]);
+}
+
+// Posição de 'nome' (um campo de STRLEN bytes) num vetor ordenado por
+// nome, depois dos iguais
+int posicaoOrdenadaPorNome(Componente arr[], int n, const char *nome) {
+    int inicio = 0, fim = n;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (chave_comparar(arr[meio].nome, nome, STRLEN) <= 0) inicio = meio + 1;
+        else fim = meio;
+    }
+    return inicio;
+}
+
+// Inserção ordenada: acha a posição por busca binária e abre espaço com um
+// único deslocamento em bloco, O(log n) comparações + O(n) bytes movidos,
+// sem reordenar. Devolve a posição ocupada.
+int adicionarComponenteOrdenado(Estoque *estoque, const Componente *c) {
+    Medicao m = medicao_iniciar();
+    Inventario *inv = &estoque->componentes;
+    int pos = posicaoOrdenadaPorNome((Componente *)inv->dados, inv->tamanho, c->nome);
+    *(Componente *)inventario_inserirEm(inv, pos) = *c;
+    if (estoque->arvoresProntas) {
+        arvoreb_inserir(&estoque->porNome, c);
+        arvoreb_inserir(&estoque->porPrioridade, c);
+    }
+    if (estoque->baldesProntos) *(Componente *)inventario_anexar(baldeTipo(estoque, c->tipo)) = *c;
+    if (estoque->filaPronta) heap_inserir(&estoque->filaMontagem, c);
+    medicao_registrar(&m, &estatisticas[EST_CADASTRO]);
+    return pos;
+}
+
+// Posição de um registro igual a 'alvo' (ordem completa) num vetor, ou -1.
+// Varredura O(n): o vetor muda de ordem a cada ordenação e não guarda
+// posições; é esse o custo dominante de retirar e atualizar.
+int posicaoRegistro(const Inventario *inv, const Componente *alvo) {
+    const Componente *arr = (const Componente *)inv->dados;
+    for (int i = 0; i < inv->tamanho; i++)
+        if (compararComponenteCompleto(&arr[i], alvo) == 0) return i;
+    return -1;
+}
+
+// Tira do estoque exatamente o registro 'alvo' (que está nas árvores):
+// árvores e fila em O(log n); vetor e balde em O(n) (busca linear da
+// posição + deslocamento que preserva a ordem)
+void retirarRegistro(Estoque *estoque, const Componente *alvo) {
+    arvoreb_remover(&estoque->porNome, alvo, NULL);
+    arvoreb_remover(&estoque->porPrioridade, alvo, NULL);
+    inventario_remover(&estoque->componentes, posicaoRegistro(&estoque->componentes, alvo));
+    if (estoque->baldesProntos) {
+        Inventario *balde = baldeTipo(estoque, alvo->tipo);
+        inventario_remover(balde, posicaoRegistro(balde, alvo));
+    }
+    if (estoque->filaPronta) {
+        int pos = heap_localizar(&estoque->filaMontagem, alvo);
+        if (pos >= 0) heap_removerEm(&estoque->filaMontagem, pos, NULL);
+    }
+}
+
+// Registro com esse nome nas árvores (o primeiro na ordem completa);
+// devolve 0 se não há nenhum
+int acharPorNome(Estoque *estoque, const char *nome, Componente *alvo) {
+    Componente sonda;
+    montarSonda(&sonda, nome, INT_MIN, 0);
+    Componente *achado = arvoreb_limiteInferior(&estoque->porNome, &sonda);
+    if (achado == NULL || strcmp(achado->nome, nome) != 0) return 0;
+    *alvo = *achado;
+    return 1;
+}
+
+// Remove um componente com esse nome: O(n) no total (ver retirarRegistro).
+// Devolve 1 se removeu.
+int removerComponente(Estoque *estoque, const char *nome, Componente *removido) {
+    garantirArvores(estoque);
+    Medicao m = medicao_iniciar();
+    Componente alvo;
+    int ok = acharPorNome(estoque, nome, &alvo);
+    if (ok) {
+        retirarRegistro(estoque, &alvo);
+        if (removido) *removido = alvo;
+    }
+    medicao_registrar(&m, &estatisticas[EST_REMOCAO]);
+    return ok;
+}
+
+// -----------------------------
+// Fila de montagem (heap de máximo por prioridade)
+// -----------------------------
+
+// Próximo componente a montar, sem tirá-lo: O(1). NULL se o estoque está vazio.
+const Componente *proximoMontagem(Estoque *estoque) {
+    garantirFila(estoque);
+    return (const Componente *)heap_topo(&estoque->filaMontagem);
+}
+
+// Retira do estoque o componente de maior prioridade. Achar o topo é O(1)
+// e tirá-lo do heap e das árvores é O(log n), mas o vetor e o balde tornam
+// a operação O(n) (ver retirarRegistro). Devolve 0 se o estoque está vazio.
+int montarProximo(Estoque *estoque, Componente *montado) {
+    garantirFila(estoque);
+    garantirArvores(estoque);
+    const Componente *topo = (const Componente *)heap_topo(&estoque->filaMontagem);
+    if (topo == NULL) return 0;
+    Medicao m = medicao_iniciar();
+    Componente alvo = *topo;
+    retirarRegistro(estoque, &alvo);
+    if (montado) *montado = alvo;
+    medicao_registrar(&m, &estatisticas[EST_FILA_MONTAGEM]);
+    return 1;
+}
+
+// Muda a prioridade do componente com esse nome em todas as estruturas.
+// No heap a posição vem do índice por nome e o registro sobe ou desce até
+// o lugar, O(log n); nas árvores é sair e voltar, O(log n). No vetor e no
+// balde a posição é achada por varredura, então o total é O(n).
+// Devolve 0 se não há componente com esse nome.
+int atualizarPrioridade(Estoque *estoque, const char *nome, int prioridade, Componente *atualizado) {
+    garantirArvores(estoque);
+    garantirFila(estoque);
+    Medicao m = medicao_iniciar();
+    Componente alvo, novo;
+    int ok = acharPorNome(estoque, nome, &alvo);
+    if (ok) {
+        novo = alvo;
+        novo.prioridade = prioridade;
+        // a prioridade faz parte da ordem das duas árvores: sai e volta
+        arvoreb_remover(&estoque->porNome, &alvo, NULL);
+        arvoreb_remover(&estoque->porPrioridade, &alvo, NULL);
+        arvoreb_inserir(&estoque->porNome, &novo);
+        arvoreb_inserir(&estoque->porPrioridade, &novo);
+        Inventario *inv = &estoque->componentes;
+        ((Componente *)inv->dados)[posicaoRegistro(inv, &alvo)] = novo;
+        if (estoque->baldesProntos) {
+            Inventario *balde = baldeTipo(estoque, alvo.tipo);
+            ((Componente *)balde->dados)[posicaoRegistro(balde, &alvo)] = novo;
+        }
+        int pos = heap_localizar(&estoque->filaMontagem, &alvo);
+        if (pos >= 0) heap_atualizar(&estoque->filaMontagem, pos, &novo);
+        if (atualizado) *atualizado = novo;
+    }
+    medicao_registrar(&m, &estatisticas[EST_FILA_MONTAGEM]);
+    return ok;
+}
+
+// Os k componentes mais importantes (ordem da fila de montagem) direto do
+// vetor, em O(n log k), sem ordená-lo nem mexer na fila: índices em sel[],
+// do primeiro ao k-ésimo. Devolve quantos (min(k, n)).
+int selecionarTopK(Componente arr[], int n, int k, int *sel, long *comparacoes) {
+    Medicao m = medicao_iniciar();
+    int total = heap_selecionarK(arr, sizeof(Componente), n, k, compararMontagem, sel, comparacoes);
+    medicao_registrar(&m, &estatisticas[EST_FILA_MONTAGEM]);
+    return total;
+}
+
+// -----------------------------
+// Consultas por faixa nas árvores B: visitam em ordem, em O(log n + k),
+// os componentes da faixa. Devolvem o número de comparações feitas.
+// -----------------------------
+long consultarFaixaPrioridade(Estoque *estoque, int min, int max, VisitaRegistro visita, void *ctx) {
+    garantirArvores(estoque);
+    Medicao m = medicao_iniciar();
+    Componente de, ate;
+    montarSonda(&de, "", min, 0);
+    montarSonda(&ate, "", max, 1);
+    estoque->porPrioridade.comparacoes = 0;
+    arvoreb_intervalo(&estoque->porPrioridade, &de, &ate, visita, ctx);
+    medicao_registrar(&m, &estatisticas[EST_CONSULTA_FAIXA]);
+    return estoque->porPrioridade.comparacoes;
+}
+
+long consultarPrefixoNome(Estoque *estoque, const char *prefixo, VisitaRegistro visita, void *ctx) {
+    garantirArvores(estoque);
+    Medicao m = medicao_iniciar();
+    Componente de, ate;
+    montarSonda(&de, prefixo, INT_MIN, 0);
+    montarSonda(&ate, prefixo, INT_MAX, 1);
+    estoque->porNome.comparacoes = 0;
+    arvoreb_intervalo(&estoque->porNome, &de, &ate, visita, ctx);
+    medicao_registrar(&m, &estatisticas[EST_CONSULTA_FAIXA]);
+    return estoque->porNome.comparacoes;
+}
+
+// Componentes de um tipo, direto do balde (sem varrer o vetor); NULL se
+// nenhum componente tem esse tipo
+const Inventario *consultarTipo(Estoque *estoque, const char *tipo) {
+    garantirBaldes(estoque);
+    int id = dicionario_buscar(&tiposComponentes, tipo);
+    if (id < 0 || id >= estoque->numBaldes || estoque->porTipo[id].tamanho == 0) return NULL;
+    return &estoque->porTipo[id];
+}
+
+// Visitante que imprime a linha da tabela e conta os componentes
+int imprimirVisitado(const void *registro, void *contador) {
+    const Componente *c = (const Componente *)registro;
+    imprimirLinhaComponente((*(int *)contador)++, c->nome, textoTipo(c->tipo), c->prioridade, c->quantidade);
+    return 1;
+}
+
+// Lê um componente com prompts e o anexa ao inventário (ou o insere na
+// posição por nome, se 'ordenado')
+void cadastrarComponente(Estoque *estoque, int ordenado) {
+    Componente novo;
+    memset(&novo, 0, sizeof(novo));
+    lerString("Nome do componente: ", novo.nome, STRLEN);
+    char tipo[TYPELEN];
+    lerString("Tipo do componente: ", tipo, TYPELEN);
+    int idTipo = internarTipo(tipo);
+    if (idTipo < 0) return;
+    novo.tipo = (uint16_t)idTipo;
+    int p;
+    do {
+        if (!entrada_lerInteiro("Prioridade (1-10): ", &p)) return; // entrada acabou
+        if (p < 1 || p > 10) printf("Prioridade deve ser entre 1 e 10.\n");
+    } while (p < 1 || p > 10);
+    novo.prioridade = p;
+    int q;
+    do {
+        if (!entrada_lerInteiro("Quantidade: ", &q)) return;
+        if (q < 0) printf("Quantidade não pode ser negativa.\n");
+    } while (q < 0);
+    novo.quantidade = q;
+    if (ordenado) {
+        int pos = adicionarComponenteOrdenado(estoque, &novo);
+        printf("Componente cadastrado na posição %d. Total agora: %d\n", pos, estoque->componentes.tamanho);
+    } else {
+        adicionarComponente(estoque, &novo);
+        printf("Componente cadastrado. Total agora: %d\n", estoque->componentes.tamanho);
+    }
+}
+
+// Pontos de entrada (lote e main) ficam de fora quando este arquivo é
+// incluído por outro programa, como o benchmark em ../benchmark.
+#ifndef FREEFIRE_SEM_MAIN
+
+// -----------------------------
+// Modo lote (--lote [arquivo]): sem prompts nem tabelas.
+// Comandos, um por linha (nome e tipo sem espaços):
+//   i <nome> <tipo> <prioridade> <quantidade>   cadastrar
+//   m 0|1                                       inserção ordenada por nome (opção 11)
+//   o <algoritmo>                               ordenar (número da opção 8)
+//   oc <algoritmo>                              ordenar no layout colunar (opção 10)
+//   oo <ordem>                                  vários critérios, ex.: tipo,-prioridade,nome (opção 23)
+//   th <threads>                                threads do Merge Sort paralelo (0: todos os núcleos)
+//   b <nome>                                    busca binária (exige ordem por nome)
+//   bp <prefixo>                                nomes com o prefixo (opção 18: vetor se ordenado
+//                                               por nome, senão árvore B)
+//   c                                           comparar todos os algoritmos (opção 7),
+//                                               inclusive os colunares
+//   cs                                          os três da linha de base ao mesmo tempo
+//   r <nome>                                    remover (opção 14)
+//   fp <min> <max>                              prioridade na faixa (opção 12)
+//   pn <prefixo>                                nomes com o prefixo (opção 13)
+//   t <tipo>                                    componentes do tipo (opção 17)
+//   prox                                        próximo a montar (opção 19)
+//   montar                                      retirar o próximo a montar (opção 20)
+//   ap <nome> <prioridade>                      atualizar prioridade (opção 21)
+//   top <k>                                     os k mais importantes (opção 22)
+//   salvar <arquivo>                            gravar snapshot (opção 15)
+//   carregar <arquivo>                          carregar snapshot (opção 16)
+//   l                                           listar
+// Devolve se o vetor terminou ordenado por nome (para o snapshot da saída).
+// -----------------------------
+
+// Visitante do lote: uma linha por componente
+int escreverVisitado(const void *registro, void *contador) {
+    const Componente *c = (const Componente *)registro;
+    printf("%s %s %d %d\n", c->nome, textoTipo(c->tipo), c->prioridade, c->quantidade);
+    (*(int *)contador)++;
+    return 1;
+}
+
+int executarLote(Lote *lote, Estoque *estoque, int ordenadoPorNome) {
+    int insercaoOrdenada = 0;
+    ColunasComponentes colunas;
+    char *cmd;
+
+    iniciarColunas(&colunas);
+
+    while ((cmd = lote_proximoComando(lote)) != NULL) {
+        Componente *componentes = (Componente *)estoque->componentes.dados;
+        int n = estoque->componentes.tamanho;
+        if (!ordenadoPorNome) insercaoOrdenada = 0; // outra ordenação desfez a ordem
+
+        if (strcmp(cmd, "i") == 0) {
+            Componente novo;
+            char tipo[TYPELEN];
+            memset(&novo, 0, sizeof(novo));
+            if (!lote_texto(lote, novo.nome, STRLEN) || !lote_texto(lote, tipo, TYPELEN) ||
+                !lote_inteiro(lote, &novo.prioridade) || !lote_inteiro(lote, &novo.quantidade)) {
+                lote_erro(lote, "uso: i <nome> <tipo> <prioridade> <quantidade>");
+                continue;
+            }
+            if (novo.prioridade < 1 || novo.prioridade > 10 || novo.quantidade < 0) {
+                lote_erro(lote, "prioridade deve ser 1-10 e quantidade >= 0");
+                continue;
+            }
+            int idTipo = internarTipo(tipo);
+            if (idTipo < 0) { lote_erro(lote, "tipos demais"); continue; }
+            novo.tipo = (uint16_t)idTipo;
+            if (insercaoOrdenada) {
+                printf("inserido %s %d\n", novo.nome, adicionarComponenteOrdenado(estoque, &novo));
+            } else {
+                adicionarComponente(estoque, &novo);
+                ordenadoPorNome = 0;
+                printf("inserido %s\n", novo.nome);
+            }
+        } else if (strcmp(cmd, "m") == 0) {
+            int ativar;
+            if (!lote_inteiro(lote, &ativar)) { lote_erro(lote, "uso: m 0|1"); continue; }
+            if (ativar && !ordenadoPorNome) {
+                long comps = 0;
+                medirTempo(mergeSortNome, componentes, n, &comps);
+                ordenadoPorNome = 1;
+            }
+            insercaoOrdenada = ativar != 0;
+            printf("insercao_ordenada %d\n", insercaoOrdenada);
+        } else if (strcmp(cmd, "r") == 0) {
+            char chave[STRLEN];
+            if (!lote_texto(lote, chave, STRLEN)) { lote_erro(lote, "uso: r <nome>"); continue; }
+            printf("%s %s\n", removerComponente(estoque, chave, NULL) ? "removido" : "nao_encontrado", chave);
+        } else if (strcmp(cmd, "fp") == 0 || strcmp(cmd, "pn") == 0) {
+            int total = 0;
+            long comps;
+            if (cmd[0] == 'f') {
+                int min, max;
+                if (!lote_inteiro(lote, &min) || !lote_inteiro(lote, &max)) {
+                    lote_erro(lote, "uso: fp <min> <max>");
+                    continue;
+                }
+                comps = consultarFaixaPrioridade(estoque, min, max, escreverVisitado, &total);
+            } else {
+                char prefixo[STRLEN];
+                if (!lote_texto(lote, prefixo, STRLEN)) { lote_erro(lote, "uso: pn <prefixo>"); continue; }
+                comps = consultarPrefixoNome(estoque, prefixo, escreverVisitado, &total);
+            }
+            printf("faixa %d comparacoes=%ld\n", total, comps);
+        } else if (strcmp(cmd, "t") == 0) {
+            char tipo[TYPELEN];
+            if (!lote_texto(lote, tipo, TYPELEN)) { lote_erro(lote, "uso: t <tipo>"); continue; }
+            const Inventario *balde = consultarTipo(estoque, tipo);
+            int total = 0;
+            for (int i = 0; balde != NULL && i < balde->tamanho; i++)
+                escreverVisitado(inventario_em(balde, i), &total);
+            printf("tipo %s %d\n", tipo, total);
+        } else if (strcmp(cmd, "prox") == 0 || strcmp(cmd, "montar") == 0) {
+            Componente c;
+            const Componente *topo = proximoMontagem(estoque);
+            int ok = topo != NULL;
+            if (ok) c = *topo;
+            if (ok && cmd[0] == 'm') ok = montarProximo(estoque, &c);
+            if (ok)
+                printf("%s %s %s %d %d\n", cmd[0] == 'p' ? "proximo" : "montado", c.nome, textoTipo(c.tipo),
+                       c.prioridade, c.quantidade);
+            else
+                printf("fila_vazia\n");
+        } else if (strcmp(cmd, "ap") == 0) {
+            char chave[STRLEN];
+            int p;
+            if (!lote_texto(lote, chave, STRLEN) || !lote_inteiro(lote, &p)) {
+                lote_erro(lote, "uso: ap <nome> <prioridade>");
+                continue;
+            }
+            if (p < 1 || p > 10) { lote_erro(lote, "prioridade deve ser 1-10"); continue; }
+            if (atualizarPrioridade(estoque, chave, p, NULL)) printf("atualizado %s %d\n", chave, p);
+            else printf("nao_encontrado %s\n", chave);
+        } else if (strcmp(cmd, "top") == 0) {
+            int k;
+            if (!lote_inteiro(lote, &k) || k < 1) { lote_erro(lote, "uso: top <k>"); continue; }
+            if (k > n) k = n;
+            int *sel = (int *)ordenacao_alocar((size_t)k * sizeof(int));
+            long comps = 0;
+            int total = selecionarTopK(componentes, n, k, sel, &comps), exibidos = 0;
+            for (int i = 0; i < total; i++) escreverVisitado(&componentes[sel[i]], &exibidos);
+            printf("top %d comparacoes=%ld\n", total, comps);
+            free(sel);
+        } else if (strcmp(cmd, "salvar") == 0 || strcmp(cmd, "carregar") == 0) {
+            char *arquivo = lote_token(lote);
+            if (arquivo == NULL) { lote_erro(lote, "falta o arquivo"); continue; }
+            if (cmd[0] == 's') {
+                if (salvarEstoque(estoque, arquivo, ordenadoPorNome)) printf("salvo %d\n", n);
+                else lote_erro(lote, "não foi possível salvar");
+            } else {
+                long long t0 = cronometro_agoraNs();
+                if (carregarEstoque(estoque, arquivo, &ordenadoPorNome))
+                    printf("carregado %d %lld\n", estoque->componentes.tamanho, cronometro_agoraNs() - t0);
+                else
+                    lote_erro(lote, "snapshot inválido");
+            }
+        } else if (strcmp(cmd, "o") == 0) {
+            int a;
+            if (!lote_inteiro(lote, &a) || a < 1 || a > NUM_ALGORITMOS) {
+                lote_erro(lote, "uso: o <algoritmo 1..N>");
+                continue;
+            }
+            a--;
+            long comps = 0;
+            long long t = medirTempo(algoritmos[a].alg, componentes, n, &comps);
+            ordenadoPorNome = (algoritmos[a].criterio == CRITERIO_NOME);
+            printf("ordenado %s %ld %lld\n", algoritmos[a].nome, comps, t);
+        } else if (strcmp(cmd, "oo") == 0) {
+            char *texto = lote_token(lote);
+            if (texto == NULL || !interpretarOrdem(texto, &ordemComposta)) {
+                lote_erro(lote, "uso: oo <campo[,-campo...]> (nome, tipo, prioridade, quantidade)");
+                continue;
+            }
+            long comps = 0;
+            long long t = medirTempo(ordenarChaveComposta, componentes, n, &comps);
+            ordenadoPorNome = ordemComecaPorNome(&ordemComposta);
+            printf("ordenado composta %ld %lld\n", comps, t);
+        } else if (strcmp(cmd, "th") == 0) {
+            int t;
+            if (!lote_inteiro(lote, &t) || t < 0 || t > PARALELO_MAX_THREADS) {
+                lote_erro(lote, "uso: th <threads 0..64>");
+                continue;
+            }
+            threadsOrdenacao = t;
+            printf("threads %d\n", threadsEmUso());
+        } else if (strcmp(cmd, "oc") == 0) {
+            int a;
+            if (!lote_inteiro(lote, &a) || a < 1 || a > NUM_ALGORITMOS_COLUNAS) {
+                lote_erro(lote, "uso: oc <algoritmo 1..N>");
+                continue;
+            }
+            a--;
+            long comps = 0;
+            long long t = medirTempoColunas(algoritmosColunas[a].alg, &colunas, componentes, n, 1, &comps);
+            ordenadoPorNome = (algoritmosColunas[a].criterio == CRITERIO_NOME);
+            printf("ordenado %s %ld %lld\n", algoritmosColunas[a].nome, comps, t);
+        } else if (strcmp(cmd, "b") == 0) {
+            char chave[STRLEN];
+            if (!lote_texto(lote, chave, STRLEN)) { lote_erro(lote, "uso: b <nome>"); continue; }
+            if (!ordenadoPorNome) { lote_erro(lote, "busca binária exige ordenação por nome"); continue; }
+            long comps = 0;
+            int pos = buscaBinariaPorNome(componentes, n, chave, &comps);
+            if (pos >= 0)
+                printf("encontrado %s %d %s %d %d comparacoes=%ld\n", chave, pos,
+                       textoTipo(componentes[pos].tipo), componentes[pos].prioridade, componentes[pos].quantidade, comps);
+            else
+                printf("nao_encontrado %s comparacoes=%ld\n", chave, comps);
+        } else if (strcmp(cmd, "bp") == 0) {
+            char prefixo[STRLEN];
+            if (!lote_texto(lote, prefixo, STRLEN)) { lote_erro(lote, "uso: bp <prefixo>"); continue; }
+            long comps = 0;
+            int total = 0;
+            if (ordenadoPorNome) {
+                int inicio;
+                total = buscaPrefixoPorNome(componentes, n, prefixo, &inicio, &comps);
+                int exibidos = 0;
+                for (int i = inicio; i < inicio + total; i++) escreverVisitado(&componentes[i], &exibidos);
+            } else {
+                // fora de ordem: mesma faixa na árvore B por nome, como na opção 18
+                comps = consultarPrefixoNome(estoque, prefixo, escreverVisitado, &total);
+            }
+            printf("prefixo %d comparacoes=%ld\n", total, comps);
+        } else if (strcmp(cmd, "c") == 0) {
+            Componente *copia = ordenacao_alocar((size_t)n * sizeof(Componente));
+            for (int a = 0; a < NUM_ALGORITMOS; a++) {
+                long c = 0;
+                copiarVetor(copia, componentes, n);
+                long long t = medirTempo(algoritmos[a].alg, copia, n, &c);
+                printf("%s;%ld;%d;%lld\n", algoritmos[a].nome, c,
+                       algoritmos[a].linear ? passesOrdenacao : 0, t);
+            }
+            for (int a = 0; a < NUM_ALGORITMOS_COLUNAS; a++) {
+                long c = 0;
+                long long t = medirTempoColunas(algoritmosColunas[a].alg, &colunas, componentes, n, 0, &c);
+                printf("%s;%ld;%d;%lld\n", algoritmosColunas[a].nome, c,
+                       algoritmosColunas[a].linear ? passesOrdenacao : 0, t);
+            }
+            free(copia);
+        } else if (strcmp(cmd, "cs") == 0) {
+            ExecucaoSimultanea exec[NUM_BASELINE];
+            for (int a = 0; a < NUM_BASELINE; a++) {
+                Componente *copia = ordenacao_alocar((size_t)n * sizeof(Componente));
+                copiarVetor(copia, componentes, n);
+                exec[a] = (ExecucaoSimultanea){ algoritmos[a].alg, copia, n, 0, 0, 0, -1 };
+            }
+            long long parede = medirTempoSimultaneo(exec, NUM_BASELINE);
+            for (int a = 0; a < NUM_BASELINE; a++)
+                printf("%s;%ld;%d;%lld\n", algoritmos[a].nome, exec[a].comparacoes, exec[a].cpu, exec[a].ns);
+            printf("parede;%lld\n", parede);
+            for (int a = 0; a < NUM_BASELINE; a++) free(exec[a].dados);
+        } else if (strcmp(cmd, "l") == 0) {
+            printf("total %d\n", n);
+            for (int i = 0; i < n; i++)
+                printf("%s %s %d %d\n", componentes[i].nome, textoTipo(componentes[i].tipo),
+                       componentes[i].prioridade, componentes[i].quantidade);
+        } else {
+            lote_erro(lote, "comando desconhecido");
+        }
+    }
+    liberarColunas(&colunas);
+    return ordenadoPorNome;
+}
+
 // -----------------------------
 // Menu e fluxo principal
 // -----------------------------
 
-int main() {
-    Componente componentes[MAX_COMPONENTES];
-    int n = 0; // número atual de componentes
+int main(int argc, char *argv[]) {
+    Estoque estoque; // componentes cadastrados
+    iniciarEstoque(&estoque);
+    iniciarEstatisticas();
+
+    // variável auxiliar para verificar se o vetor está ordenado por nome
+    int ordenadoPorNome = 0;
+
+    // --snapshot <arquivo>: carrega se já existir e salva ao sair
+    const char *arquivoSnapshot = snapshot_argumento(argc, argv);
+    long long tempoCarga = -1;
+    if (arquivoSnapshot != NULL) {
+        FILE *existe = fopen(arquivoSnapshot, "rb");
+        if (existe != NULL) {
+            fclose(existe);
+            long long t0 = cronometro_agoraNs();
+            if (!carregarEstoque(&estoque, arquivoSnapshot, &ordenadoPorNome)) {
+                liberarEstoque(&estoque);
+                return 1;
+            }
+            tempoCarga = cronometro_agoraNs() - t0;
+        }
+    }
+
+    if (lote_solicitado(argc, argv)) {
+        Lote lote;
+        int ok = lote_abrir(&lote, argc, argv);
+        if (ok) {
+            ordenadoPorNome = executarLote(&lote, &estoque, ordenadoPorNome);
+            lote_fechar(&lote);
+            if (arquivoSnapshot != NULL) ok = salvarEstoque(&estoque, arquivoSnapshot, ordenadoPorNome);
+        }
+        paralelo_encerrar(&paralelo_pool);
+        liberarEstoque(&estoque);
+        return ok ? 0 : 1;
+    }
 
     printf("=== Módulo Final: Montagem da Torre de Resgate ===\n");
+    if (tempoCarga >= 0)
+        printf("Snapshot '%s' carregado: %d componentes em %s.\n", arquivoSnapshot,
+               estoque.componentes.tamanho, cronometro_texto(tempoCarga));
 
     // Cadastro inicial (opcional repetível via menu)
     while (1) {
         printf("\n(1) Cadastrar componentes  (2) Entrar no menu principal\n");
         int escolha = lerInteiro("Escolha: ");
         if (escolha == 1) {
-            if (n >= MAX_COMPONENTES) {
-                printf("Limite atingido (%d componentes). Não é possível cadastrar mais.\n", MAX_COMPONENTES);
-                continue;
-            }
-            lerString("Nome do componente: ", componentes[n].nome, STRLEN);
-            lerString("Tipo do componente: ", componentes[n].tipo, TYPELEN);
-            int p;
-            do {
-                p = lerInteiro("Prioridade (1-10): ");
-                if (p < 1 || p > 10) printf("Prioridade deve ser entre 1 e 10.\n");
-            } while (p < 1 || p > 10);
-            componentes[n].prioridade = p;
-            n++;
-            printf("Componente cadastrado. Total agora: %d\n", n);
-        } else if (escolha == 2) {
+            cadastrarComponente(&estoque, 0);
+        } else if (escolha == 2 || entrada_esgotada(&entrada_teclado)) {
             break;
         } else {
             printf("Opção inválida.\n");
@@ -220,10 +1660,21 @@ int main() {
 
     // Menu principal
     int opc = -1;
-    // variável auxiliar para verificar se o vetor está ordenado por nome
-    int ordenadoPorNome = 0;
+    // com ela ligada, os cadastros mantêm a ordem por nome (opção 11)
+    int insercaoOrdenada = 0;
+    ColunasComponentes colunas; // cópia colunar derivada, refeita nas opções 7 e 10
+    iniciarColunas(&colunas);
 
     while (opc != 0) {
+        // o inventário pode ter sido realocado por um cadastro
+        Componente *componentes = (Componente *)estoque.componentes.dados;
+        int n = estoque.componentes.tamanho;
+
+        if (insercaoOrdenada && !ordenadoPorNome) {
+            insercaoOrdenada = 0;
+            printf("(Inserção ordenada desligada: o vetor foi ordenado por outro critério.)\n");
+        }
+
         printf("\n===== MENU PRINCIPAL =====\n");
         printf("1 - Mostrar componentes\n");
         printf("2 - Cadastrar novo componente\n");
@@ -232,59 +1683,64 @@ int main() {
         printf("5 - Ordenar por Prioridade (Selection Sort)\n");
         printf("6 - Busca binária por Nome (apenas se ordenado por nome)\n");
         printf("7 - Medir/Comparar todos os algoritmos (mesmos dados)\n");
+        printf("8 - Ordenar com outro algoritmo (Introsort, Merge Sort...)\n");
+        printf("9 - Estatísticas de tempo por operação\n");
+        printf("10 - Ordenar no layout colunar (um vetor por campo)\n");
+        printf("11 - %s inserção ordenada por nome\n", insercaoOrdenada ? "Desligar" : "Ligar");
+        printf("12 - Consultar por faixa de prioridade (árvore B)\n");
+        printf("13 - Consultar nomes por prefixo (árvore B)\n");
+        printf("14 - Remover componente por nome\n");
+        printf("15 - Salvar snapshot binário\n");
+        printf("16 - Carregar snapshot binário\n");
+        printf("17 - Listar componentes de um tipo\n");
+        printf("18 - Buscar por começo do nome (autocompletar)\n");
+        printf("19 - Próximo componente a montar (maior prioridade)\n");
+        printf("20 - Montar o próximo componente (retira do estoque)\n");
+        printf("21 - Atualizar a prioridade de um componente\n");
+        printf("22 - Os K componentes mais importantes (top-K)\n");
+        printf("23 - Ordenar por vários critérios (chave normalizada)\n");
         printf("0 - Sair\n");
         opc = lerInteiro("Escolha: ");
 
         if (opc == 1) {
-            mostrarComponentes(componentes, n);
+            mostrarComponentes(componentes, n, 0);
         } else if (opc == 2) {
-            if (n >= MAX_COMPONENTES) {
-                printf("Não é possível cadastrar mais (cheio).\n");
-            } else {
-                lerString("Nome do componente: ", componentes[n].nome, STRLEN);
-                lerString("Tipo do componente: ", componentes[n].tipo, TYPELEN);
-                int p;
-                do {
-                    p = lerInteiro("Prioridade (1-10): ");
-                    if (p < 1 || p > 10) printf("Prioridade deve ser entre 1 e 10.\n");
-                } while (p < 1 || p > 10);
-                componentes[n].prioridade = p;
-                n++;
-                printf("Componente cadastrado. Total agora: %d\n", n);
-                ordenadoPorNome = 0; // nova adição quebra ordenação por nome
-            }
+            cadastrarComponente(&estoque, insercaoOrdenada);
+            // sem inserção ordenada, a nova adição quebra a ordenação por nome
+            if (!insercaoOrdenada) ordenadoPorNome = 0;
         } else if (opc == 3) {
             if (n == 0) { printf("Vetor vazio.\n"); continue; }
             long comps = 0;
             // ordenar in-place (modifica componentes)
-            double t = medirTempo(bubbleSortNome, componentes, n, &comps);
+            long long t = medirTempo(bubbleSortNome, componentes, n, &comps);
             printf("Bubble Sort (por nome) finalizado.\n");
             printf("Comparações (strcmp): %ld\n", comps);
-            printf("Tempo: %.6f s\n", t);
+            printf("Tempo: %s\n", cronometro_texto(t));
             ordenadoPorNome = 1;
-            mostrarComponentes(componentes, n);
+            mostrarComponentes(componentes, n, LISTAGEM_MAXIMA);
         } else if (opc == 4) {
             if (n == 0) { printf("Vetor vazio.\n"); continue; }
             long comps = 0;
-            double t = medirTempo(insertionSortTipo, componentes, n, &comps);
+            long long t = medirTempo(insertionSortTipo, componentes, n, &comps);
             printf("Insertion Sort (por tipo) finalizado.\n");
-            printf("Comparações (strcmp): %ld\n", comps);
-            printf("Tempo: %.6f s\n", t);
+            printf("Comparações (int): %ld\n", comps);
+            printf("Tempo: %s\n", cronometro_texto(t));
             ordenadoPorNome = 0;
-            mostrarComponentes(componentes, n);
+            mostrarComponentes(componentes, n, LISTAGEM_MAXIMA);
         } else if (opc == 5) {
             if (n == 0) { printf("Vetor vazio.\n"); continue; }
             long comps = 0;
-            double t = medirTempo(selectionSortPrioridade, componentes, n, &comps);
+            long long t = medirTempo(selectionSortPrioridade, componentes, n, &comps);
             printf("Selection Sort (por prioridade) finalizado.\n");
             printf("Comparações (int): %ld\n", comps);
-            printf("Tempo: %.6f s\n", t);
+            printf("Tempo: %s\n", cronometro_texto(t));
             ordenadoPorNome = 0;
-            mostrarComponentes(componentes, n);
+            mostrarComponentes(componentes, n, LISTAGEM_MAXIMA);
         } else if (opc == 6) {
             if (!ordenadoPorNome) {
                 printf("Atenção: a busca binária requer que o vetor esteja ordenado por NOME.\n");
-                printf("Ordene por nome (opção 3) antes de usar a busca binária.\n");
+                printf("Ordene por nome (opção 3) antes de usar a busca binária,\n");
+                printf("ou ligue a inserção ordenada (opção 11) para mantê-lo sempre ordenado.\n");
                 continue;
             }
             if (n == 0) { printf("Vetor vazio.\n"); continue; }
@@ -294,8 +1750,9 @@ int main() {
             int pos = buscaBinariaPorNome(componentes, n, chave, &comps);
             if (pos >= 0) {
                 printf("Componente encontrado no índice %d.\n", pos);
-                printf("Nome: %s | Tipo: %s | Prioridade: %d\n",
-                       componentes[pos].nome, componentes[pos].tipo, componentes[pos].prioridade);
+                printf("Nome: %s | Tipo: %s | Prioridade: %d | Quantidade: %d\n",
+                       componentes[pos].nome, textoTipo(componentes[pos].tipo), componentes[pos].prioridade,
+                       componentes[pos].quantidade);
             } else {
                 printf("Componente '%s' não encontrado.\n", chave);
             }
@@ -303,32 +1760,259 @@ int main() {
         } else if (opc == 7) {
             if (n == 0) { printf("Vetor vazio.\n"); continue; }
             // Cópias dos dados para testar os 3 algoritmos sem interferência
-            Componente copia1[MAX_COMPONENTES], copia2[MAX_COMPONENTES], copia3[MAX_COMPONENTES];
+            Componente *copia1 = malloc((size_t)n * sizeof(Componente));
+            Componente *copia2 = malloc((size_t)n * sizeof(Componente));
+            Componente *copia3 = malloc((size_t)n * sizeof(Componente));
+            if (!copia1 || !copia2 || !copia3) {
+                printf("Memória insuficiente para as cópias.\n");
+                free(copia1); free(copia2); free(copia3);
+                continue;
+            }
             copiarVetor(copia1, componentes, n);
             copiarVetor(copia2, componentes, n);
             copiarVetor(copia3, componentes, n);
 
-            long c1=0, c2=0, c3=0;
-            double t1 = medirTempo(bubbleSortNome, copia1, n, &c1);
-            double t2 = medirTempo(insertionSortTipo, copia2, n, &c2);
-            double t3 = medirTempo(selectionSortPrioridade, copia3, n, &c3);
+            // Os três ao mesmo tempo, cada um na sua thread e no seu núcleo
+            Componente *copias[NUM_BASELINE] = { copia1, copia2, copia3 };
+            ExecucaoSimultanea exec[NUM_BASELINE];
+            for (int a = 0; a < NUM_BASELINE; a++)
+                exec[a] = (ExecucaoSimultanea){ algoritmos[a].alg, copias[a], n, 0, 0, 0, -1 };
+            long long parede = medirTempoSimultaneo(exec, NUM_BASELINE);
+
+            printf("\n--- Resultados de comparação (mesmos dados originais, em paralelo) ---\n");
+            long long soma = 0;
+            for (int a = 0; a < NUM_BASELINE; a++) {
+                printf("%s: %s=%ld, Tempo=%s", algoritmos[a].nome, algoritmos[a].medida,
+                       exec[a].comparacoes, cronometro_texto(exec[a].ns));
+                if (exec[a].cpu >= 0) printf(", CPU %d", exec[a].cpu);
+                printf("\n");
+                soma += exec[a].ns;
+            }
+            printf("Tempo de parede dos três: %s (em sequência: %s)\n", cronometro_texto(parede),
+                   cronometro_texto(soma));
 
-            printf("\n--- Resultados de comparação (mesmos dados originais) ---\n");
-            printf("Bubble Sort (nome): Comparações(strcmp)=%ld, Tempo=%.6f s\n", c1, t1);
-            printf("Insertion Sort (tipo): Comparações(strcmp)=%ld, Tempo=%.6f s\n", c2, t2);
-            printf("Selection Sort (prioridade): Comparações(int)=%ld, Tempo=%.6f s\n", c3, t3);
+            // Demais algoritmos da tabela, cada um sobre uma cópia nova
+            Componente *copia = malloc((size_t)n * sizeof(Componente));
+            if (copia != NULL) {
+                for (int a = NUM_BASELINE; a < NUM_ALGORITMOS; a++) {
+                    long c = 0;
+                    copiarVetor(copia, componentes, n);
+                    long long t = medirTempo(algoritmos[a].alg, copia, n, &c);
+                    if (algoritmos[a].linear)
+                        printf("%s: %s=%ld, Passagens=%d, Tempo=%s\n",
+                               algoritmos[a].nome, algoritmos[a].medida, c, passesOrdenacao, cronometro_texto(t));
+                    else
+                        printf("%s: %s=%ld, Tempo=%s\n", algoritmos[a].nome, algoritmos[a].medida, c,
+                               cronometro_texto(t));
+                }
+                free(copia);
+            }
+
+            // Mesmos critérios sobre o layout colunar, recarregado a cada algoritmo
+            // (a transposição entra no tempo)
+            printf("\n--- Layout colunar (mesmos dados) ---\n");
+            for (int a = 0; a < NUM_ALGORITMOS_COLUNAS; a++) {
+                long c = 0;
+                long long t = medirTempoColunas(algoritmosColunas[a].alg, &colunas, componentes, n, 0, &c);
+                if (algoritmosColunas[a].linear)
+                    printf("%s: %s=%ld, Passagens=%d, Tempo=%s\n", algoritmosColunas[a].nome,
+                           algoritmosColunas[a].medida, c, passesOrdenacao, cronometro_texto(t));
+                else
+                    printf("%s: %s=%ld, Tempo=%s\n", algoritmosColunas[a].nome,
+                           algoritmosColunas[a].medida, c, cronometro_texto(t));
+            }
+
+            mostrarSpeedupParalelo(componentes, n);
 
             printf("\nVetor ordenado por nome (exemplo - bubble):\n");
-            mostrarComponentes(copia1, n);
+            mostrarComponentes(copia1, n, LISTAGEM_MAXIMA);
 
             printf("\nVetor ordenado por tipo (exemplo - insertion):\n");
-            mostrarComponentes(copia2, n);
+            mostrarComponentes(copia2, n, LISTAGEM_MAXIMA);
 
             printf("\nVetor ordenado por prioridade (exemplo - selection):\n");
-            mostrarComponentes(copia3, n);
+            mostrarComponentes(copia3, n, LISTAGEM_MAXIMA);
 
             // Observação: este teste NÃO altera o vetor original 'componentes'
             printf("\n(Observação: os resultados acima são de cópias; o vetor original não foi modificado.)\n");
+            free(copia1);
+            free(copia2);
+            free(copia3);
+        } else if (opc == 8) {
+            if (n == 0) { printf("Vetor vazio.\n"); continue; }
+            printf("\n--- Algoritmos disponíveis ---\n");
+            for (int a = 0; a < NUM_ALGORITMOS; a++) {
+                printf("%d - %s\n", a + 1, algoritmos[a].nome);
+            }
+            int a = lerInteiro("Algoritmo: ") - 1;
+            if (a < 0 || a >= NUM_ALGORITMOS) { printf("Opção inválida.\n"); continue; }
+            long comps = 0;
+            long long t = medirTempo(algoritmos[a].alg, componentes, n, &comps);
+            printf("%s finalizado.\n", algoritmos[a].nome);
+            printf("%s: %ld\n", algoritmos[a].medida, comps);
+            if (algoritmos[a].linear) printf("Passagens: %d\n", passesOrdenacao);
+            printf("Tempo: %s\n", cronometro_texto(t));
+            ordenadoPorNome = (algoritmos[a].criterio == CRITERIO_NOME);
+            mostrarComponentes(componentes, n, LISTAGEM_MAXIMA);
+        } else if (opc == 9) {
+            mostrarEstatisticas();
+        } else if (opc == 10) {
+            if (n == 0) { printf("Vetor vazio.\n"); continue; }
+            printf("\n--- Algoritmos no layout colunar ---\n");
+            for (int a = 0; a < NUM_ALGORITMOS_COLUNAS; a++) {
+                printf("%d - %s\n", a + 1, algoritmosColunas[a].nome);
+            }
+            int a = lerInteiro("Algoritmo: ") - 1;
+            if (a < 0 || a >= NUM_ALGORITMOS_COLUNAS) { printf("Opção inválida.\n"); continue; }
+            long comps = 0;
+            // a ordem obtida vale também para o inventário (exportada dentro da medição)
+            long long t = medirTempoColunas(algoritmosColunas[a].alg, &colunas, componentes, n, 1, &comps);
+            printf("%s finalizado.\n", algoritmosColunas[a].nome);
+            printf("%s: %ld\n", algoritmosColunas[a].medida, comps);
+            if (algoritmosColunas[a].linear) printf("Passagens: %d\n", passesOrdenacao);
+            printf("Tempo: %s (inclui transpor para colunas e de volta)\n", cronometro_texto(t));
+            mostrarColunas(&colunas, LISTAGEM_MAXIMA);
+            ordenadoPorNome = (algoritmosColunas[a].criterio == CRITERIO_NOME);
+        } else if (opc == 11) {
+            if (insercaoOrdenada) {
+                insercaoOrdenada = 0;
+                printf("Inserção ordenada desligada: novos cadastros vão para o fim.\n");
+                continue;
+            }
+            if (!ordenadoPorNome) {
+                // uma única ordenação O(n log n); daí em diante só inserções no lugar
+                long comps = 0;
+                long long t = medirTempo(mergeSortNome, componentes, n, &comps);
+                printf("Vetor ordenado por nome (Merge Sort): %ld comparações, %s.\n", comps,
+                       cronometro_texto(t));
+                ordenadoPorNome = 1;
+            }
+            insercaoOrdenada = 1;
+            printf("Inserção ordenada ligada: a busca binária fica sempre disponível.\n");
+        } else if (opc == 12 || opc == 13) {
+            int total = 0;
+            long comps;
+            printf("\n----- Consulta na árvore B -----\n");
+            if (opc == 12) {
+                int min = lerInteiro("Prioridade mínima: ");
+                int max = lerInteiro("Prioridade máxima: ");
+                imprimirTitulosComponentes("#");
+                comps = consultarFaixaPrioridade(&estoque, min, max, imprimirVisitado, &total);
+            } else {
+                char prefixo[STRLEN];
+                lerString("Prefixo do nome: ", prefixo, STRLEN);
+                imprimirTitulosComponentes("#");
+                comps = consultarPrefixoNome(&estoque, prefixo, imprimirVisitado, &total);
+            }
+            saida_descarregar(&saida_tabela);
+            printf("%d componente(s) na faixa; comparações na árvore: %ld\n", total, comps);
+        } else if (opc == 14) {
+            if (n == 0) { printf("Vetor vazio.\n"); continue; }
+            char chave[STRLEN];
+            lerString("Nome do componente a remover: ", chave, STRLEN);
+            if (removerComponente(&estoque, chave, NULL))
+                printf("Componente '%s' removido. Total agora: %d\n", chave, estoque.componentes.tamanho);
+            else
+                printf("Componente '%s' não encontrado.\n", chave);
+        } else if (opc == 15 || opc == 16) {
+            char arquivo[256];
+            lerString("Arquivo do snapshot: ", arquivo, sizeof(arquivo));
+            if (opc == 15) {
+                if (salvarEstoque(&estoque, arquivo, ordenadoPorNome))
+                    printf("%d componentes salvos em '%s'.\n", n, arquivo);
+            } else {
+                long long t0 = cronometro_agoraNs();
+                if (carregarEstoque(&estoque, arquivo, &ordenadoPorNome)) {
+                    printf("%d componentes carregados em %s.\n", estoque.componentes.tamanho,
+                           cronometro_texto(cronometro_agoraNs() - t0));
+                    insercaoOrdenada = 0;
+                }
+            }
+        } else if (opc == 17) {
+            char tipo[TYPELEN];
+            lerString("Tipo: ", tipo, TYPELEN);
+            const Inventario *balde = consultarTipo(&estoque, tipo);
+            if (balde == NULL) printf("Nenhum componente do tipo '%s'.\n", tipo);
+            else mostrarComponentes((Componente *)balde->dados, balde->tamanho, 0);
+        } else if (opc == 18) {
+            char prefixo[STRLEN];
+            printf("\n----- Busca por começo do nome -----\n");
+            lerString("Começo do nome: ", prefixo, STRLEN);
+            int total = 0;
+            long comps;
+            imprimirTitulosComponentes(ordenadoPorNome ? "Idx" : "#");
+            if (ordenadoPorNome) {
+                // vetor ordenado: faixa contígua, com os índices do vetor
+                int inicio;
+                total = buscaPrefixoPorNome(componentes, n, prefixo, &inicio, &comps);
+                for (int i = inicio; i < inicio + total; i++)
+                    imprimirLinhaComponente(i, componentes[i].nome, textoTipo(componentes[i].tipo),
+                                            componentes[i].prioridade, componentes[i].quantidade);
+            } else {
+                // fora de ordem: mesma faixa na árvore B por nome
+                comps = consultarPrefixoNome(&estoque, prefixo, imprimirVisitado, &total);
+            }
+            saida_descarregar(&saida_tabela);
+            printf("%d componente(s) começam com '%s'; comparações: %ld (%s)\n", total, prefixo, comps,
+                   ordenadoPorNome ? "vetor ordenado" : "árvore B");
+        } else if (opc == 19 || opc == 20) {
+            const Componente *topo = proximoMontagem(&estoque);
+            if (topo == NULL) { printf("Nenhum componente na fila de montagem.\n"); continue; }
+            Componente c = *topo;
+            if (opc == 20) montarProximo(&estoque, &c);
+            printf("%s: %s (%s), prioridade %d, quantidade %d.\n",
+                   opc == 19 ? "Próximo a montar" : "Montado", c.nome, textoTipo(c.tipo), c.prioridade,
+                   c.quantidade);
+            if (opc == 20) printf("Restam %d componente(s) no estoque.\n", estoque.componentes.tamanho);
+        } else if (opc == 21) {
+            if (n == 0) { printf("Vetor vazio.\n"); continue; }
+            char chave[STRLEN];
+            lerString("Nome do componente: ", chave, STRLEN);
+            int p;
+            do {
+                if (!entrada_lerInteiro("Nova prioridade (1-10): ", &p)) break;
+                if (p < 1 || p > 10) printf("Prioridade deve ser entre 1 e 10.\n");
+            } while (p < 1 || p > 10);
+            if (p < 1 || p > 10) continue; // entrada acabou
+            if (atualizarPrioridade(&estoque, chave, p, NULL)) printf("Prioridade de '%s' agora é %d.\n", chave, p);
+            else printf("Componente '%s' não encontrado.\n", chave);
+        } else if (opc == 22) {
+            if (n == 0) { printf("Vetor vazio.\n"); continue; }
+            int k = lerInteiro("Quantos (K): ");
+            if (k < 1) { printf("K deve ser pelo menos 1.\n"); continue; }
+            if (k > n) k = n;
+            int *sel = (int *)ordenacao_alocar((size_t)k * sizeof(int));
+            long comps = 0;
+            int total = selecionarTopK(componentes, n, k, sel, &comps);
+            imprimirTitulosComponentes("#");
+            for (int i = 0; i < total; i++)
+                imprimirLinhaComponente(i, componentes[sel[i]].nome, textoTipo(componentes[sel[i]].tipo),
+                                        componentes[sel[i]].prioridade, componentes[sel[i]].quantidade);
+            saida_descarregar(&saida_tabela);
+            printf("Top-%d por prioridade: %ld comparações (heap de %d, sem ordenar o vetor).\n", total, comps,
+                   total);
+            free(sel);
+        } else if (opc == 23) {
+            if (n == 0) { printf("Vetor vazio.\n"); continue; }
+            char texto[128];
+            printf("\nCampos: nome, tipo, prioridade, quantidade (ou a inicial), separados por vírgula;\n");
+            printf("'-' na frente ordena decrescente. Exemplo: tipo,-prioridade,nome\n");
+            lerString("Ordem: ", texto, sizeof(texto));
+            if (!interpretarOrdem(texto, &ordemComposta)) { printf("Ordem inválida.\n"); continue; }
+            // referência numa cópia: o comparador encadeado, campo a campo
+            Componente *copia = malloc((size_t)n * sizeof(Componente));
+            if (copia == NULL) { printf("Memória insuficiente.\n"); continue; }
+            copiarVetor(copia, componentes, n);
+            long compsCadeia = 0, comps = 0;
+            long long tCadeia = medirTempo(mergeSortComposto, copia, n, &compsCadeia);
+            free(copia);
+            long long t = medirTempo(ordenarChaveComposta, componentes, n, &comps);
+            printf("Chave normalizada (%zu bytes, memcmp): %ld comparações, %s (com a codificação)\n",
+                   larguraChave(&ordemComposta), comps, cronometro_texto(t));
+            printf("Comparador encadeado (referência):  %ld comparações, %s\n", compsCadeia,
+                   cronometro_texto(tCadeia));
+            ordenadoPorNome = ordemComecaPorNome(&ordemComposta);
+            mostrarComponentes(componentes, n, LISTAGEM_MAXIMA);
         } else if (opc == 0) {
             printf("Encerrando módulo. Boa sorte na fuga!\n");
         } else {
@@ -336,5 +2020,13 @@ int main() {
         }
     }
 
+    if (arquivoSnapshot != NULL && salvarEstoque(&estoque, arquivoSnapshot, ordenadoPorNome))
+        printf("Estoque salvo em '%s'.\n", arquivoSnapshot);
+
+    paralelo_encerrar(&paralelo_pool);
+    liberarColunas(&colunas);
+    liberarEstoque(&estoque);
     return 0;
 }
+
+#endif // FREEFIRE_SEM_MAIN
@@ -1,8 +1,22 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L // pread, fdatasync, clock_gettime (../comum/wal.h, ../comum/cronometro.h)
+#endif
+
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
+
+#include "../comum/inventario.h"
+#include "../comum/indice.h"
+#include "../comum/entrada.h"
+#include "../comum/lote.h"
+#include "../comum/snapshot.h"
+#include "../comum/wal.h"
+#include "../comum/tabela.h"
 
-#define MAX_ITENS 10
+// Itens mostrados depois de cada inserção/remoção (a opção 4 lista todos)
+#define LISTAGEM_APOS_ALTERACAO 10
 
 // ---------------------------------------------------------
 // STRUCT ITEM: representa cada objeto da mochila do jogador
@@ -16,63 +30,143 @@ typedef struct {
 
 // ---------------------------------------------------------
 // Função: listarItens
-// Exibe todos os itens cadastrados na mochila
+// Exibe os 'limite' primeiros itens da mochila (limite <= 0: todos).
+// O texto é montado no buffer de saída e vai à tela de uma vez.
 // ---------------------------------------------------------
-void listarItens(Item mochila[], int contador) {
-    printf("\n===== ITENS NA MOCHILA =====\n");
+void listarItens(Item mochila[], int contador, int limite) {
+    BufferSaida *s = &saida_tabela;
+    saida_linha(s);
+    saida_texto(s, "\n===== ITENS NA MOCHILA =====\n");
 
     if (contador == 0) {
-        printf("A mochila está vazia.\n");
+        saida_texto(s, "A mochila está vazia.\n");
+        saida_descarregar(s);
         return;
     }
 
-    for (int i = 0; i < contador; i++) {
-        printf("Item %d:\n", i + 1);
-        printf("Nome: %s\n", mochila[i].nome);
-        printf("Tipo: %s\n", mochila[i].tipo);
-        printf("Quantidade: %d\n\n", mochila[i].quantidade);
+    int exibir = limite > 0 && limite < contador ? limite : contador;
+    for (int i = 0; i < exibir; i++) {
+        saida_linha(s);
+        saida_texto(s, "Item ");
+        saida_inteiro(s, i + 1, 0);
+        saida_texto(s, ":\nNome: ");
+        saida_texto(s, mochila[i].nome);
+        saida_texto(s, "\nTipo: ");
+        saida_texto(s, mochila[i].tipo);
+        saida_texto(s, "\nQuantidade: ");
+        saida_inteiro(s, mochila[i].quantidade, 0);
+        saida_texto(s, "\n\n");
     }
+    saida_restantes(s, contador - exibir, "opção 4 lista todos");
+    saida_descarregar(s);
 }
 
 
 // ---------------------------------------------------------
 // Função: buscarItem
-// Procedimento de busca sequencial pelo nome
+// Busca pelo nome usando o índice hash (tempo constante)
 // Retorna o índice encontrado ou -1 se não encontrar
 // ---------------------------------------------------------
-int buscarItem(Item mochila[], int contador, char nome[]) {
-    for (int i = 0; i < contador; i++) {
-        if (strcmp(mochila[i].nome, nome) == 0) {
-            return i;
-        }
-    }
-    return -1; // não encontrou
+int buscarItem(IndiceNome *indice, char nome[]) {
+    return indice_buscar(indice, nome, NULL); // -1 se não encontrou
 }
 
 
 // ---------------------------------------------------------
-// Função: inserirItem
-// Cadastra novo item na mochila
+// Função: adicionarItem
+// Anexa o item à mochila e ao índice (sem entrada/saída)
 // ---------------------------------------------------------
-void inserirItem(Item mochila[], int *contador) {
-    if (*contador >= MAX_ITENS) {
-        printf("\nA mochila está cheia! Não é possível adicionar mais itens.\n");
-        return;
+void adicionarItem(Inventario *mochila, IndiceNome *indice, const Item *item) {
+    *(Item *)inventario_anexar(mochila) = *item;
+    indice_inserir(indice, mochila->tamanho - 1);
+}
+
+
+// ---------------------------------------------------------
+// Função: retirarItem
+// Remove o item pelo nome (achado pelo índice) e desloca os seguintes,
+// mantendo a ordem de cadastro.
+// Retorna 1 se removeu, 0 se não encontrou
+// ---------------------------------------------------------
+int retirarItem(Inventario *mochila, IndiceNome *indice, const char *nome) {
+    int pos = indice_buscar(indice, nome, NULL);
+    if (pos == -1) return 0;
+
+    // desloca itens para a esquerda e corrige as posições no índice
+    indice_remover(indice, pos);
+    inventario_remover(mochila, pos);
+    indice_deslocar(indice, pos + 1, -1);
+    return 1;
+}
+
+
+// ---------------------------------------------------------
+// Persistência (--wal <base>): snapshot em <base>.snap e log de
+// operações em <base>.log, reproduzido por cima do snapshot ao iniciar
+// ---------------------------------------------------------
+typedef struct {
+    Inventario *mochila;
+    IndiceNome *indice;
+} EstadoMochila;
+
+// Reaplica uma operação lida do log
+void aplicarOperacao(void *contexto, int op, const void *dados, size_t tamanho) {
+    EstadoMochila *e = (EstadoMochila *)contexto;
+    if (op == WAL_OP_INSERIR && tamanho == sizeof(Item)) {
+        adicionarItem(e->mochila, e->indice, (const Item *)dados);
+    } else if (op == WAL_OP_REMOVER && tamanho > 0) {
+        char nome[30];
+        memcpy(nome, dados, tamanho < sizeof(nome) ? tamanho : sizeof(nome));
+        nome[sizeof(nome) - 1] = '\0';
+        retirarItem(e->mochila, e->indice, nome);
     }
+}
 
-    Item novo;
+// Compactação (processo filho): a mochila inteira vira o novo snapshot
+int gravarSnapshotMochila(void *contexto, const char *caminho, uint64_t sequencia) {
+    Inventario *mochila = (Inventario *)contexto;
+    return snapshot_gravar(caminho, "ITEM", mochila->dados, sizeof(Item), mochila->tamanho, 0, sequencia);
+}
 
-    printf("\nDigite o nome do item: ");
-    scanf("%s", novo.nome);
+// Carrega <base>.snap (se existir), reproduz <base>.log e deixa o log
+// aberto. Retorna 0 se algum dos dois estiver corrompido.
+int abrirPersistencia(const char *base, Inventario *mochila, IndiceNome *indice,
+                      Snapshot *snap, Wal *log) {
+    char caminhoSnap[512], caminhoLog[512];
+    snprintf(caminhoSnap, sizeof(caminhoSnap), "%s.snap", base);
+    snprintf(caminhoLog, sizeof(caminhoLog), "%s.log", base);
+
+    FILE *existe = fopen(caminhoSnap, "rb");
+    if (existe != NULL) {
+        fclose(existe);
+        if (!snapshot_carregar(snap, caminhoSnap, "ITEM", sizeof(Item))) return 0;
+        inventario_adotar(mochila, snap->registros, snap->quantidade);
+        indice_reconstruir(indice);
+    }
 
-    printf("Digite o tipo do item (arma, municao, cura...): ");
-    scanf("%s", novo.tipo);
+    EstadoMochila estado = { mochila, indice };
+    if (wal_abrir(log, caminhoLog, "ITEM", snap->sequencia, aplicarOperacao, &estado) < 0) return 0;
+    wal_definirCompactacao(log, caminhoSnap, WAL_LIMITE_COMPACTACAO, gravarSnapshotMochila, mochila);
+    return 1;
+}
 
-    printf("Digite a quantidade: ");
-    scanf("%d", &novo.quantidade);
 
-    mochila[*contador] = novo;
-    (*contador)++;
+// ---------------------------------------------------------
+// Função: inserirItem
+// Cadastra novo item na mochila (cresce conforme necessário)
+// ---------------------------------------------------------
+void inserirItem(Inventario *mochila, IndiceNome *indice, Wal *log) {
+    Item novo;
+    memset(&novo, 0, sizeof(novo));
+
+    // entrada encerrada no meio do cadastro: nada é adicionado
+    if (!entrada_lerTexto("\nDigite o nome do item: ", novo.nome, sizeof(novo.nome))) return;
+    if (!entrada_lerTexto("Digite o tipo do item (arma, municao, cura...): ", novo.tipo, sizeof(novo.tipo))) return;
+    if (!entrada_lerInteiro("Digite a quantidade: ", &novo.quantidade)) return;
+
+    adicionarItem(mochila, indice, &novo);
+    wal_registrar(log, WAL_OP_INSERIR, &novo, sizeof(novo));
+    wal_sincronizar(log); // só confirma depois de gravado
 
     printf("\nItem adicionado com sucesso!\n");
 }
@@ -80,46 +174,136 @@ void inserirItem(Item mochila[], int *contador) {
 
 // ---------------------------------------------------------
 // Função: removerItem
-// Remove item pelo nome e ajusta o vetor
+// Pede o nome e remove o item da mochila
 // ---------------------------------------------------------
-void removerItem(Item mochila[], int *contador) {
-    if (*contador == 0) {
+void removerItem(Inventario *mochila, IndiceNome *indice, Wal *log) {
+    if (mochila->tamanho == 0) {
         printf("\nA mochila já está vazia.\n");
         return;
     }
 
     char nomeRemover[30];
-    printf("\nDigite o nome do item que deseja remover: ");
-    scanf("%s", nomeRemover);
+    if (!entrada_lerTexto("\nDigite o nome do item que deseja remover: ", nomeRemover, sizeof(nomeRemover))) return;
 
-    int pos = buscarItem(mochila, *contador, nomeRemover);
-
-    if (pos == -1) {
+    if (!retirarItem(mochila, indice, nomeRemover)) {
         printf("\nItem não encontrado.\n");
         return;
     }
+    wal_registrar(log, WAL_OP_REMOVER, nomeRemover, strlen(nomeRemover) + 1);
+    wal_sincronizar(log);
 
-    // desloca itens para a esquerda
-    for (int i = pos; i < *contador - 1; i++) {
-        mochila[i] = mochila[i + 1];
-    }
+    printf("\nItem removido com sucesso!\n");
+}
 
-    (*contador)--;
 
-    printf("\nItem removido com sucesso!\n");
+// ---------------------------------------------------------
+// Função: proximoComandoLote
+// Próximo comando do lote. O grupo pendente do log vai ao disco quando
+// passa da idade máxima, mesmo que a entrada fique parada esperando.
+// ---------------------------------------------------------
+char *proximoComandoLote(Lote *lote, Wal *log) {
+    wal_sincronizarVencido(log);
+    long long prazo = wal_prazoNs(log);
+    if (prazo > 0 && !lote_aguardarComando(lote, prazo)) wal_sincronizar(log);
+    return lote_proximoComando(lote);
+}
+
+// ---------------------------------------------------------
+// Função: executarLote
+// Modo não interativo (--lote). Comandos, um por linha:
+//   i <nome> <tipo> <quantidade>   inserir
+//   r <nome>                       remover
+//   b <nome>                       buscar
+//   l                              listar
+// Com --wal, inserções e remoções vão ao log em grupos (commit em grupo).
+// ---------------------------------------------------------
+void executarLote(Lote *lote, Inventario *mochila, IndiceNome *indice, Wal *log) {
+    char *cmd;
+    char nome[30];
+
+    while ((cmd = proximoComandoLote(lote, log)) != NULL) {
+        if (strcmp(cmd, "i") == 0) {
+            Item novo;
+            memset(&novo, 0, sizeof(novo));
+            if (!lote_texto(lote, novo.nome, sizeof(novo.nome)) ||
+                !lote_texto(lote, novo.tipo, sizeof(novo.tipo)) ||
+                !lote_inteiro(lote, &novo.quantidade)) {
+                lote_erro(lote, "uso: i <nome> <tipo> <quantidade>");
+                continue;
+            }
+            adicionarItem(mochila, indice, &novo);
+            wal_registrar(log, WAL_OP_INSERIR, &novo, sizeof(novo));
+            printf("inserido %s\n", novo.nome);
+        } else if (strcmp(cmd, "r") == 0) {
+            if (!lote_texto(lote, nome, sizeof(nome))) { lote_erro(lote, "uso: r <nome>"); continue; }
+            if (retirarItem(mochila, indice, nome)) {
+                wal_registrar(log, WAL_OP_REMOVER, nome, strlen(nome) + 1);
+                printf("removido %s\n", nome);
+            } else {
+                printf("nao_encontrado %s\n", nome);
+            }
+        } else if (strcmp(cmd, "b") == 0) {
+            if (!lote_texto(lote, nome, sizeof(nome))) { lote_erro(lote, "uso: b <nome>"); continue; }
+            int pos = buscarItem(indice, nome);
+            if (pos == -1) {
+                printf("nao_encontrado %s\n", nome);
+            } else {
+                Item *it = (Item *)inventario_em(mochila, pos);
+                printf("encontrado %d %s %s %d\n", pos, it->nome, it->tipo, it->quantidade);
+            }
+        } else if (strcmp(cmd, "l") == 0) {
+            Item *itens = (Item *)mochila->dados;
+            printf("total %d\n", mochila->tamanho);
+            for (int i = 0; i < mochila->tamanho; i++) {
+                printf("%s %s %d\n", itens[i].nome, itens[i].tipo, itens[i].quantidade);
+            }
+        } else {
+            lote_erro(lote, "comando desconhecido");
+        }
+    }
 }
 
 
 // ---------------------------------------------------------
 // PROGRAMA PRINCIPAL
 // Menu com opções de gerenciamento da mochila
+// (ou modo lote, se chamado com --lote [arquivo])
+// Com --wal <base>, o estado sobrevive entre execuções.
 // ---------------------------------------------------------
-int main() {
+int main(int argc, char *argv[]) {
 
-    Item mochila[MAX_ITENS];
-    int contador = 0;
+    Arena arena;
+    Inventario mochila;
+    IndiceNome indice; // nome -> posição na mochila
     int opcao;
 
+    arena_iniciar(&arena);
+    inventario_iniciar(&mochila, &arena, sizeof(Item));
+    indice_iniciar(&indice, &mochila, offsetof(Item, nome));
+
+    Snapshot snap; // região mapeada para onde a mochila pode apontar
+    Wal log;       // desligado sem --wal
+    snapshot_iniciar(&snap);
+    wal_iniciar(&log);
+    const char *base = wal_argumento(argc, argv);
+    int ok = base == NULL || abrirPersistencia(base, &mochila, &indice, &snap, &log);
+
+    if (ok && lote_solicitado(argc, argv)) {
+        Lote lote;
+        ok = lote_abrir(&lote, argc, argv);
+        if (ok) {
+            executarLote(&lote, &mochila, &indice, &log);
+            lote_fechar(&lote);
+        }
+    }
+    if (!ok || lote_solicitado(argc, argv)) {
+        wal_fechar(&log);
+        indice_liberar(&indice);
+        arena_liberar(&arena);
+        snapshot_liberar(&snap);
+        return ok ? 0 : 1;
+    }
+
     do {
         printf("\n========== MENU DO INVENTARIO ==========\n");
         printf("1 - Inserir item\n");
@@ -127,41 +311,40 @@ int main() {
         printf("3 - Buscar item\n");
         printf("4 - Listar itens\n");
         printf("0 - Sair\n");
-        printf("Escolha uma opcao: ");
-        scanf("%d", &opcao);
+        entrada_lerInteiro("Escolha uma opcao: ", &opcao); // fim da entrada: 0 (sair)
 
         switch (opcao) {
 
             case 1:
-                inserirItem(mochila, &contador);
-                listarItens(mochila, contador);
+                inserirItem(&mochila, &indice, &log);
+                listarItens((Item *)mochila.dados, mochila.tamanho, LISTAGEM_APOS_ALTERACAO);
                 break;
 
             case 2:
-                removerItem(mochila, &contador);
-                listarItens(mochila, contador);
+                removerItem(&mochila, &indice, &log);
+                listarItens((Item *)mochila.dados, mochila.tamanho, LISTAGEM_APOS_ALTERACAO);
                 break;
 
             case 3: {
                 char nomeBusca[30];
-                printf("\nDigite o nome do item para busca: ");
-                scanf("%s", nomeBusca);
+                entrada_lerTexto("\nDigite o nome do item para busca: ", nomeBusca, sizeof(nomeBusca));
 
-                int pos = buscarItem(mochila, contador, nomeBusca);
+                Item *itens = (Item *)mochila.dados;
+                int pos = buscarItem(&indice, nomeBusca);
 
                 if (pos == -1) {
                     printf("\nItem nao encontrado.\n");
                 } else {
                     printf("\nItem encontrado:\n");
-                    printf("Nome: %s\n", mochila[pos].nome);
-                    printf("Tipo: %s\n", mochila[pos].tipo);
-                    printf("Quantidade: %d\n", mochila[pos].quantidade);
+                    printf("Nome: %s\n", itens[pos].nome);
+                    printf("Tipo: %s\n", itens[pos].tipo);
+                    printf("Quantidade: %d\n", itens[pos].quantidade);
                 }
                 break;
             }
 
             case 4:
-                listarItens(mochila, contador);
+                listarItens((Item *)mochila.dados, mochila.tamanho, 0);
                 break;
 
             case 0:
@@ -174,6 +357,10 @@ int main() {
 
     } while (opcao != 0);
 
+    wal_fechar(&log);
+    indice_liberar(&indice);
+    arena_liberar(&arena);
+    snapshot_liberar(&snap);
     return 0;
 }
 